@@ -0,0 +1,228 @@
+#pragma once
+
+#include <memory>
+
+#include "queue.h"
+
+namespace collections {
+	/// <summary>
+	/// Growable circular buffer, O(1) push and pop at both ends and O(1) indexing
+	/// <para>Elements are stored in at most two contiguous segments, capacity is a power of two</para>
+	/// </summary>
+	template<typename T>
+	class ArrayDeque : public Queue<T> {
+	private:
+		T* m_Buffer;
+
+		int m_Capacity;
+		int m_Count;
+
+		/// <summary>
+		/// Buffer index of the first element
+		/// </summary>
+		int m_Head;
+
+		/// Buffer index of the element at idx
+		int Slot(int idx) {
+			return (m_Head + idx) & (m_Capacity - 1);
+		}
+
+		void UpdateAllocations(int capacity) {
+			if (capacity <= m_Capacity) return;
+
+			//round up to a power of two
+			int size = 4;
+			while (size < capacity) {
+				size *= 2;
+			}
+
+			T* buf = new T[size];
+			memset(buf, 0, sizeof(T) * size);
+
+			//unwrap into the new buffer
+			if (m_Buffer != 0) {
+				int first = m_Capacity - m_Head < m_Count ? m_Capacity - m_Head : m_Count;
+				memcpy(buf, m_Buffer + m_Head, sizeof(T) * first);
+				memcpy(buf + first, m_Buffer, sizeof(T) * (m_Count - first));
+
+				delete[] m_Buffer;
+			}
+
+			m_Buffer = buf;
+			m_Capacity = size;
+			m_Head = 0;
+		}
+
+		// Increases capacity if needed
+		void CheckCapacity() {
+			if (m_Count == m_Capacity) {
+				UpdateAllocations(m_Capacity * 2);
+			}
+		}
+
+	public:
+		ArrayDeque(int initialCapacity = 16) : m_Buffer(0), m_Capacity(0), m_Count(0), m_Head(0) {
+			UpdateAllocations(initialCapacity);
+		}
+
+		ArrayDeque(const ArrayDeque&) = delete;
+		ArrayDeque& operator=(const ArrayDeque&) = delete;
+
+		~ArrayDeque() {
+			if (m_Buffer) {
+				delete[] m_Buffer;
+			}
+		}
+
+		/// <summary>
+		/// Adds an element at the back
+		/// </summary>
+		void PushBack(T val) {
+			CheckCapacity();
+
+			m_Buffer[Slot(m_Count++)] = val;
+		}
+
+		/// <summary>
+		/// Adds an element at the front
+		/// </summary>
+		void PushFront(T val) {
+			CheckCapacity();
+
+			m_Head = (m_Head - 1) & (m_Capacity - 1);
+			m_Buffer[m_Head] = val;
+
+			m_Count++;
+		}
+
+		/// <summary>
+		/// Removes the front element
+		/// </summary>
+		bool PopFront(T* val = 0) {
+			if (m_Count == 0) return false;
+
+			if (val) {
+				*val = m_Buffer[m_Head];
+			}
+
+			m_Head = Slot(1);
+			m_Count--;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Removes the back element
+		/// </summary>
+		bool PopBack(T* val = 0) {
+			if (m_Count == 0) return false;
+
+			if (val) {
+				*val = m_Buffer[Slot(m_Count - 1)];
+			}
+
+			m_Count--;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Returns the back element
+		/// </summary>
+		bool PeekBack(T* val = 0) {
+			if (m_Count == 0) return false;
+
+			if (val) {
+				*val = m_Buffer[Slot(m_Count - 1)];
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Accesses an item using an index from the front
+		/// </summary>
+		T* operator[](int idx) {
+			if (idx >= m_Count || idx < 0) return 0;
+
+			return &m_Buffer[Slot(idx)];
+		}
+
+		/// <summary>
+		/// Returns the contiguous segments holding the elements in order
+		/// <para>Returns the number of segments (0-2), the second segment is only used when the buffer wraps</para>
+		/// </summary>
+		int GetSegments(T** first, int* firstCount, T** second, int* secondCount) {
+			*first = *second = 0;
+			*firstCount = *secondCount = 0;
+
+			if (m_Count == 0) return 0;
+
+			*first = m_Buffer + m_Head;
+			*firstCount = m_Capacity - m_Head < m_Count ? m_Capacity - m_Head : m_Count;
+
+			if (*firstCount == m_Count) return 1;
+
+			*second = m_Buffer;
+			*secondCount = m_Count - *firstCount;
+
+			return 2;
+		}
+
+		/// <summary>
+		/// Reserves memory in the buffer
+		/// </summary>
+		void Reserve(int capacity) {
+			UpdateAllocations(capacity);
+		}
+
+		/// <summary>
+		/// Enqueues an element to the end of queue
+		/// </summary>
+		virtual void Enqueue(T val) override {
+			PushBack(val);
+		}
+
+		/// <summary>
+		/// Attempts to dequeue an element from the queue
+		/// </summary>
+		virtual bool Dequeue(T* val = 0) override {
+			return PopFront(val);
+		}
+
+		/// <summary>
+		/// Is the queue empty?
+		/// </summary>
+		virtual bool IsEmpty() override {
+			return m_Count == 0;
+		}
+
+		/// <summary>
+		/// Length of queue elements
+		/// </summary>
+		virtual int GetLength() override {
+			return m_Count;
+		}
+
+		/// <summary>
+		/// Attempts to peek at the beginning of the queue
+		/// </summary>
+		virtual bool Peek(T* val = 0) override {
+			if (m_Count == 0) return false;
+
+			if (val) {
+				*val = m_Buffer[m_Head];
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Clears the queue
+		/// </summary>
+		virtual void Clear() override {
+			m_Count = 0;
+			m_Head = 0;
+		}
+	};
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <memory>
+
+#include "queue.h"
+
+namespace collections {
+	/// <summary>
+	/// Pri-Queue implemented using an array backed binary heap
+	/// <para>Equal priorities are dequeued in insertion order, same as LinkedPriorityQueue</para>
+	/// </summary>
+	template<typename T, typename Comp>
+	class ArrayPriorityQueue : public Queue<T> {
+	protected:
+		struct Entry {
+			T value;
+
+			/// <summary>
+			/// Insertion order, breaks priority ties
+			/// </summary>
+			unsigned long long order;
+		};
+
+		/// <summary>
+		/// Heap array
+		/// </summary>
+		Entry* m_Heap;
+
+		int m_Count;
+		int m_Capacity;
+
+		/// <summary>
+		/// Insertion counter
+		/// </summary>
+		unsigned long long m_Order;
+
+		/// Does entry a come before entry b?
+		bool Before(const Entry& a, const Entry& b) {
+			Comp c = Comp();
+			if (c(a.value, b.value)) return true;
+			if (c(b.value, a.value)) return false;
+
+			//same priority, first in first out
+			return a.order < b.order;
+		}
+
+		void SiftUp(int i) {
+			Entry entry = m_Heap[i];
+
+			while (i > 0) {
+				int parent = (i - 1) / 2;
+				if (!Before(entry, m_Heap[parent])) break;
+
+				m_Heap[i] = m_Heap[parent];
+				i = parent;
+			}
+
+			m_Heap[i] = entry;
+		}
+
+		void SiftDown(int i) {
+			Entry entry = m_Heap[i];
+
+			while (true) {
+				int child = 2 * i + 1;
+				if (child >= m_Count) break;
+
+				//pick the higher priority child
+				if (child + 1 < m_Count && Before(m_Heap[child + 1], m_Heap[child])) {
+					child++;
+				}
+
+				if (!Before(m_Heap[child], entry)) break;
+
+				m_Heap[i] = m_Heap[child];
+				i = child;
+			}
+
+			m_Heap[i] = entry;
+		}
+
+		void UpdateAllocations(int capacity) {
+			if (capacity <= m_Capacity) return;
+
+			Entry* heap = new Entry[capacity];
+
+			if (m_Heap != 0) {
+				memcpy(heap, m_Heap, sizeof(Entry) * m_Count);
+				delete[] m_Heap;
+			}
+
+			m_Heap = heap;
+			m_Capacity = capacity;
+		}
+
+	public:
+		ArrayPriorityQueue(int initialCapacity = 16) : m_Heap(0), m_Count(0), m_Capacity(0), m_Order(0) {
+			UpdateAllocations(initialCapacity > 0 ? initialCapacity : 1);
+		}
+
+		~ArrayPriorityQueue() {
+			if (m_Heap) {
+				delete[] m_Heap;
+			}
+		}
+
+		/// <summary>
+		/// Enqueues an element with respect to its priority
+		/// </summary>
+		virtual void Enqueue(T val) override {
+			if (m_Count == m_Capacity) {
+				UpdateAllocations(m_Capacity * 2);
+			}
+
+			int pos = m_Count++;
+			m_Heap[pos] = Entry{ val, m_Order++ };
+			SiftUp(pos);
+		}
+
+		/// <summary>
+		/// Attempts to dequeue the highest priority element
+		/// </summary>
+		virtual bool Dequeue(T* val = 0) override {
+			//cant dequeue if empty
+			if (m_Count == 0) return false;
+
+			//get value
+			if (val) {
+				*val = m_Heap[0].value;
+			}
+
+			//move the last entry to the top and let it sink
+			if (--m_Count > 0) {
+				m_Heap[0] = m_Heap[m_Count];
+				SiftDown(0);
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Is the queue empty?
+		/// </summary>
+		virtual bool IsEmpty() override {
+			return m_Count == 0;
+		}
+
+		/// <summary>
+		/// Length of queue elements
+		/// </summary>
+		virtual int GetLength() override {
+			return m_Count;
+		}
+
+		/// <summary>
+		/// Attempts to peek at the highest priority element
+		/// </summary>
+		virtual bool Peek(T* val = 0) override {
+			//false if empty
+			if (m_Count == 0) return false;
+
+			//look at top
+			if (val) {
+				*val = m_Heap[0].value;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Clears the queue
+		/// </summary>
+		virtual void Clear() override {
+			m_Count = 0;
+		}
+	};
+}
\ No newline at end of file
@@ -15,6 +15,9 @@ namespace collections {
 	private:
 		BinaryTreeNode<T>* m_Root;
 
+		// Was the root created by Insert? foreign roots are owned by the caller
+		bool m_OwnsRoot;
+
 		BinaryTreeNode<T>* FindNodeWithValue(BinaryTreeNode<T>* node, T& value) {
 			if (node == 0) return 0;
 
@@ -35,12 +38,12 @@ namespace collections {
 		}
 
 	public:
-		BinaryTree() : m_Root(0) {
+		BinaryTree() : m_Root(0), m_OwnsRoot(false) {
 		}
 
 		~BinaryTree() {
 			//since this BT is only used for forking, each Node will be a root and should delete itself
-			if (m_Root) {
+			if (m_Root && m_OwnsRoot) {
 				delete m_Root;
 			}
 		}
@@ -55,6 +58,9 @@ namespace collections {
 			if (!InsertForeign(parent, node)) {
 				delete node;
 			}
+			else if (parent == 0) {
+				m_OwnsRoot = true;
+			}
 		}
 
 		// Inserts a foreign node into this binary tree
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <memory>
+
+namespace collections {
+	/// <summary>
+	/// Binary heap of integer ids (0..capacity-1) keyed by an int
+	/// <para>Any id can be updated or removed in O(log n), equal keys are ordered by the smaller id</para>
+	/// </summary>
+	template<typename Comp>
+	class IndexedHeap {
+	private:
+		/// <summary>
+		/// Heap array of ids
+		/// </summary>
+		int* m_Heap;
+
+		/// <summary>
+		/// Position of each id in the heap, -1 if not contained
+		/// </summary>
+		int* m_Positions;
+
+		/// <summary>
+		/// Key of each id
+		/// </summary>
+		int* m_Keys;
+
+		int m_Count;
+		int m_Capacity;
+
+		/// Does id a come before id b?
+		bool Before(int a, int b) {
+			Comp c = Comp();
+			if (c(m_Keys[a], m_Keys[b])) return true;
+			if (c(m_Keys[b], m_Keys[a])) return false;
+
+			//tie, smaller id first
+			return a < b;
+		}
+
+		void Swap(int i, int j) {
+			int tmp = m_Heap[i];
+			m_Heap[i] = m_Heap[j];
+			m_Heap[j] = tmp;
+
+			m_Positions[m_Heap[i]] = i;
+			m_Positions[m_Heap[j]] = j;
+		}
+
+		void SiftUp(int i) {
+			while (i > 0) {
+				int parent = (i - 1) / 2;
+				if (!Before(m_Heap[i], m_Heap[parent])) break;
+
+				Swap(i, parent);
+				i = parent;
+			}
+		}
+
+		void SiftDown(int i) {
+			while (true) {
+				int left = 2 * i + 1;
+				int right = left + 1;
+				int best = i;
+
+				if (left < m_Count && Before(m_Heap[left], m_Heap[best])) best = left;
+				if (right < m_Count && Before(m_Heap[right], m_Heap[best])) best = right;
+
+				if (best == i) break;
+
+				Swap(i, best);
+				i = best;
+			}
+		}
+
+	public:
+		IndexedHeap(int capacity = 0) : m_Heap(0), m_Positions(0), m_Keys(0), m_Count(0), m_Capacity(0) {
+			Reserve(capacity);
+		}
+
+		~IndexedHeap() {
+			if (m_Heap) {
+				delete[] m_Heap;
+				delete[] m_Positions;
+				delete[] m_Keys;
+			}
+		}
+
+		/// <summary>
+		/// Grows the id range to [0, capacity)
+		/// </summary>
+		void Reserve(int capacity) {
+			if (capacity <= m_Capacity) return;
+
+			int* heap = new int[capacity];
+			int* positions = new int[capacity];
+			int* keys = new int[capacity];
+
+			//new ids are not contained
+			memset(positions, 0xff, sizeof(int) * capacity);
+
+			if (m_Heap != 0) {
+				memcpy(heap, m_Heap, sizeof(int) * m_Count);
+				memcpy(positions, m_Positions, sizeof(int) * m_Capacity);
+				memcpy(keys, m_Keys, sizeof(int) * m_Capacity);
+
+				delete[] m_Heap;
+				delete[] m_Positions;
+				delete[] m_Keys;
+			}
+
+			m_Heap = heap;
+			m_Positions = positions;
+			m_Keys = keys;
+			m_Capacity = capacity;
+		}
+
+		/// <summary>
+		/// Inserts the id, or updates its key if already contained
+		/// </summary>
+		void Set(int id, int key) {
+			if (id < 0) return;
+
+			if (id >= m_Capacity) {
+				Reserve(id >= m_Capacity * 2 ? id + 1 : m_Capacity * 2);
+			}
+
+			int pos = m_Positions[id];
+			if (pos == -1) {
+				m_Keys[id] = key;
+
+				pos = m_Count++;
+				m_Heap[pos] = id;
+				m_Positions[id] = pos;
+
+				SiftUp(pos);
+				return;
+			}
+
+			int oldKey = m_Keys[id];
+			m_Keys[id] = key;
+
+			//restore heap order in whichever direction the key moved
+			if (Comp()(key, oldKey)) {
+				SiftUp(pos);
+			}
+			else {
+				SiftDown(pos);
+			}
+		}
+
+		/// <summary>
+		/// Removes the id from the heap
+		/// </summary>
+		bool Remove(int id) {
+			if (!Contains(id)) return false;
+
+			int pos = m_Positions[id];
+			int last = --m_Count;
+
+			m_Positions[id] = -1;
+
+			if (pos != last) {
+				//move last element into the hole
+				int moved = m_Heap[last];
+				m_Heap[pos] = moved;
+				m_Positions[moved] = pos;
+
+				//moved element may need to go either way
+				SiftUp(pos);
+				SiftDown(m_Positions[moved]);
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Is the id in the heap?
+		/// </summary>
+		bool Contains(int id) {
+			return id >= 0 && id < m_Capacity && m_Positions[id] != -1;
+		}
+
+		/// <summary>
+		/// Returns the key of a contained id
+		/// </summary>
+		int GetKey(int id) {
+			return m_Keys[id];
+		}
+
+		/// <summary>
+		/// Attempts to peek at the top id
+		/// </summary>
+		bool Peek(int* id = 0) {
+			if (m_Count == 0) return false;
+
+			if (id) {
+				*id = m_Heap[0];
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Is the heap empty?
+		/// </summary>
+		bool IsEmpty() {
+			return m_Count == 0;
+		}
+
+		/// <summary>
+		/// Number of ids in the heap
+		/// </summary>
+		int GetLength() {
+			return m_Count;
+		}
+
+		/// <summary>
+		/// Clears the heap
+		/// </summary>
+		void Clear() {
+			for (int i = 0; i < m_Count; i++) {
+				m_Positions[m_Heap[i]] = -1;
+			}
+
+			m_Count = 0;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "queue.h"
+
+namespace collections {
+	/// <summary>
+	/// Links embedded in an element of an IntrusiveList
+	/// </summary>
+	template<typename T>
+	struct IntrusiveListHook {
+		/// <summary>
+		/// Previous element
+		/// </summary>
+		T* prev;
+
+		/// <summary>
+		/// Next element
+		/// </summary>
+		T* next;
+
+		/// <summary>
+		/// The list the element is linked in, null if not linked
+		/// </summary>
+		void* list;
+	};
+
+	/// <summary>
+	/// Doubly linked list whose links live inside the elements
+	/// <para>HookAccessor()(T*) returns the IntrusiveListHook of an element. An element can be in one list per hook,
+	/// linking and unlinking anywhere are O(1) and never allocate</para>
+	/// </summary>
+	template<typename T, typename HookAccessor>
+	class IntrusiveList : public Queue<T*> {
+	protected:
+		/// <summary>
+		/// First element
+		/// </summary>
+		T* m_Head;
+
+		/// <summary>
+		/// Last element
+		/// </summary>
+		T* m_Tail;
+
+		int m_Count;
+
+		static IntrusiveListHook<T>* Hook(T* element) {
+			HookAccessor accessor = HookAccessor();
+			return accessor(element);
+		}
+
+	public:
+		IntrusiveList() : m_Head(0), m_Tail(0), m_Count(0) {
+		}
+
+		IntrusiveList(const IntrusiveList&) = delete;
+		IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+		/// <summary>
+		/// Returns the first element, null if empty
+		/// </summary>
+		T* GetHead() {
+			return m_Head;
+		}
+
+		/// <summary>
+		/// Returns the last element, null if empty
+		/// </summary>
+		T* GetTail() {
+			return m_Tail;
+		}
+
+		/// <summary>
+		/// Returns the element after element, null if it is the last one
+		/// </summary>
+		T* GetNext(T* element) {
+			return Hook(element)->next;
+		}
+
+		/// <summary>
+		/// Is the element linked in this list? O(1)
+		/// </summary>
+		bool Contains(T* element) {
+			return element != 0 && Hook(element)->list == this;
+		}
+
+		/// <summary>
+		/// Links an element at the end, false if it is already linked in a list
+		/// </summary>
+		bool PushBack(T* element) {
+			IntrusiveListHook<T>* hook = Hook(element);
+			if (hook->list != 0) return false;
+
+			hook->prev = m_Tail;
+			hook->next = 0;
+			hook->list = this;
+
+			if (m_Tail != 0) {
+				Hook(m_Tail)->next = element;
+			}
+			else {
+				m_Head = element;
+			}
+
+			m_Tail = element;
+			m_Count++;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Unlinks an element from anywhere in the list, false if it isnt linked in this list
+		/// </summary>
+		bool Remove(T* element) {
+			if (!Contains(element)) return false;
+
+			IntrusiveListHook<T>* hook = Hook(element);
+
+			if (hook->prev != 0) {
+				Hook(hook->prev)->next = hook->next;
+			}
+			else {
+				m_Head = hook->next;
+			}
+
+			if (hook->next != 0) {
+				Hook(hook->next)->prev = hook->prev;
+			}
+			else {
+				m_Tail = hook->prev;
+			}
+
+			hook->prev = hook->next = 0;
+			hook->list = 0;
+
+			m_Count--;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Enqueues an element to the end of queue
+		/// </summary>
+		virtual void Enqueue(T* val) override {
+			PushBack(val);
+		}
+
+		/// <summary>
+		/// Attempts to dequeue an element from the queue
+		/// </summary>
+		virtual bool Dequeue(T** val = 0) override {
+			if (m_Head == 0) return false;
+
+			if (val) {
+				*val = m_Head;
+			}
+
+			return Remove(m_Head);
+		}
+
+		/// <summary>
+		/// Is the queue empty?
+		/// </summary>
+		virtual bool IsEmpty() override {
+			return m_Head == 0;
+		}
+
+		/// <summary>
+		/// Length of queue elements
+		/// </summary>
+		virtual int GetLength() override {
+			return m_Count;
+		}
+
+		/// <summary>
+		/// Attempts to peek at the beginning of the queue
+		/// </summary>
+		virtual bool Peek(T** val = 0) override {
+			if (m_Head == 0) return false;
+
+			if (val) {
+				*val = m_Head;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Unlinks every element, elements are not deleted
+		/// </summary>
+		virtual void Clear() override {
+			while (m_Head != 0) {
+				Remove(m_Head);
+			}
+		}
+	};
+}
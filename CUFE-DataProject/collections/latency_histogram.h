@@ -0,0 +1,163 @@
+#pragma once
+
+#include <memory>
+#include <climits>
+
+// Sub buckets per power of two, relative error of a bucket is 1/LATENCY_HISTOGRAM_HALF_SUB_BUCKETS
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 6
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define LATENCY_HISTOGRAM_HALF_SUB_BUCKETS (LATENCY_HISTOGRAM_SUB_BUCKETS / 2)
+
+// Enough buckets for any non negative int
+#define LATENCY_HISTOGRAM_BUCKETS ((31 - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 2) * LATENCY_HISTOGRAM_HALF_SUB_BUCKETS)
+
+namespace collections {
+	/// <summary>
+	/// Log bucketed (HDR style) histogram of non negative ints
+	/// <para>Values below LATENCY_HISTOGRAM_SUB_BUCKETS are exact, above that every power of two is split into
+	/// LATENCY_HISTOGRAM_HALF_SUB_BUCKETS buckets. Memory is fixed regardless of the number of values</para>
+	/// </summary>
+	class LatencyHistogram {
+	private:
+		/// <summary>
+		/// Number of values per bucket
+		/// </summary>
+		long long m_Counts[LATENCY_HISTOGRAM_BUCKETS];
+
+		long long m_TotalCount;
+
+		int m_Min;
+		int m_Max;
+
+	public:
+		LatencyHistogram() {
+			Clear();
+		}
+
+		/// <summary>
+		/// Returns the bucket of a value
+		/// </summary>
+		static int GetBucketIndex(int value) {
+			if (value < LATENCY_HISTOGRAM_SUB_BUCKETS) return value < 0 ? 0 : value;
+
+			//position of the highest set bit
+			int msb = 0;
+			for (unsigned int v = (unsigned int)value; v > 1; v >>= 1) {
+				msb++;
+			}
+
+			//keep the top LATENCY_HISTOGRAM_SUB_BUCKET_BITS bits
+			int shift = msb - (LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1);
+			return shift * LATENCY_HISTOGRAM_HALF_SUB_BUCKETS + (value >> shift);
+		}
+
+		/// <summary>
+		/// Returns the highest value that falls in a bucket
+		/// </summary>
+		static int GetBucketHighestValue(int index) {
+			if (index < LATENCY_HISTOGRAM_SUB_BUCKETS) return index;
+
+			int shift = index / LATENCY_HISTOGRAM_HALF_SUB_BUCKETS - 1;
+			long long sub = index % LATENCY_HISTOGRAM_HALF_SUB_BUCKETS + LATENCY_HISTOGRAM_HALF_SUB_BUCKETS;
+
+			long long highest = ((sub + 1) << shift) - 1;
+			return highest > INT_MAX ? INT_MAX : (int)highest;
+		}
+
+		/// <summary>
+		/// Records a value, negative values are recorded as 0
+		/// </summary>
+		void Record(int value, long long count = 1) {
+			if (value < 0) value = 0;
+
+			m_Counts[GetBucketIndex(value)] += count;
+
+			if (m_TotalCount == 0 || value < m_Min) m_Min = value;
+			if (m_TotalCount == 0 || value > m_Max) m_Max = value;
+
+			m_TotalCount += count;
+		}
+
+		/// <summary>
+		/// Adds the values of another histogram
+		/// </summary>
+		void Merge(LatencyHistogram& other) {
+			if (other.m_TotalCount == 0) return;
+
+			for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+				m_Counts[i] += other.m_Counts[i];
+			}
+
+			if (m_TotalCount == 0 || other.m_Min < m_Min) m_Min = other.m_Min;
+			if (m_TotalCount == 0 || other.m_Max > m_Max) m_Max = other.m_Max;
+
+			m_TotalCount += other.m_TotalCount;
+		}
+
+		/// <summary>
+		/// Returns the value at a percentile (0-100), within the bucket precision, 0 if empty
+		/// </summary>
+		int GetPercentile(double percentile) {
+			if (m_TotalCount == 0) return 0;
+
+			//rank of the value, 1 based
+			long long rank = (long long)(percentile / 100.0 * m_TotalCount + 0.5);
+			if (rank < 1) rank = 1;
+			if (rank > m_TotalCount) rank = m_TotalCount;
+
+			long long seen = 0;
+			for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+				seen += m_Counts[i];
+
+				if (seen >= rank) {
+					//never report past the recorded range
+					int value = GetBucketHighestValue(i);
+					return value > m_Max ? m_Max : value < m_Min ? m_Min : value;
+				}
+			}
+
+			return m_Max;
+		}
+
+		/// <summary>
+		/// Number of values in a bucket
+		/// </summary>
+		long long GetBucketCount(int index) {
+			if (index < 0 || index >= LATENCY_HISTOGRAM_BUCKETS) return 0;
+
+			return m_Counts[index];
+		}
+
+		/// <summary>
+		/// Number of recorded values
+		/// </summary>
+		long long GetTotalCount() {
+			return m_TotalCount;
+		}
+
+		/// <summary>
+		/// Smallest recorded value, 0 if empty
+		/// </summary>
+		int GetMin() {
+			return m_Min;
+		}
+
+		/// <summary>
+		/// Largest recorded value, 0 if empty
+		/// </summary>
+		int GetMax() {
+			return m_Max;
+		}
+
+		/// <summary>
+		/// Removes all values
+		/// </summary>
+		void Clear() {
+			memset(m_Counts, 0, sizeof(long long) * LATENCY_HISTOGRAM_BUCKETS);
+
+			m_TotalCount = 0;
+			m_Min = 0;
+			m_Max = 0;
+		}
+	};
+}
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "list.h"
+#include "object_pool.h"
+
+// Max nodes per chunk of a linked collection node pool
+#define LINKED_NODE_CHUNK_SIZE 256
 
 namespace collections {
 	/// <summary>
@@ -30,11 +34,27 @@ namespace collections {
 		}
 	};
 
+	/// <summary>
+	/// Default node allocator of the linked collections, every list keeps its own pool of chunked nodes
+	/// <para>Meant for long lived lists, small lists embedded in many objects should use HeapAllocator so freed nodes go back to a shared store</para>
+	/// </summary>
 	template<typename T>
+	using LinkedNodePool = ObjectPool<LinkedListNode<T>, LINKED_NODE_CHUNK_SIZE>;
+
+	/// <summary>
+	/// Doubly linked list, nodes come from Allocator (ObjectPool interface)
+	/// <para>Node addresses stay valid until the node is deleted</para>
+	/// </summary>
+	template<typename T, typename Allocator = LinkedNodePool<T>>
 	class LinkedList : public List<T> {
 	private:
 		int m_Count;
 
+		/// <summary>
+		/// Node allocator
+		/// </summary>
+		Allocator m_Allocator;
+
 	protected:
 		/// <summary>
 		/// Linked list head
@@ -134,8 +154,8 @@ namespace collections {
 				m_Head = node->next;
 			}
 
-			//delete ptr
-			delete node;
+			//return node to the allocator
+			m_Allocator.Destroy((LinkedListNode<T>*)node);
 
 			//decrement counter
 			m_Count--;
@@ -147,7 +167,7 @@ namespace collections {
 		/// Adds an element to the list
 		/// </summary>
 		virtual void Add(T val) override {
-			auto node = new LinkedListNode<T>(val);
+			auto node = m_Allocator.Create(val);
 
 			//if head is null
 			if (m_Head == 0) {
@@ -182,7 +202,7 @@ namespace collections {
 				return true;
 			}
 
-			LinkedListNode<T>* node = new LinkedListNode<T>(val);
+			LinkedListNode<T>* node = m_Allocator.Create(val);
 			LinkedListNode<T>* oldNode = GetNodeAtIndex(pos);
 
 			node->prev = oldNode->prev;
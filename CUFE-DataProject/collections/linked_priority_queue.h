@@ -7,13 +7,13 @@ namespace collections {
 	/// <summary>
 	/// Pri-Queue implemented using a LinkedList
 	/// </summary>
-	template<typename T, typename Comp>
+	template<typename T, typename Comp, typename Allocator = LinkedNodePool<T>>
 	class LinkedPriorityQueue : public Queue<T> {
 	protected:
 		/// <summary>
 		/// The underlying linked list
 		/// </summary>
-		LinkedList<T> m_LinkedList;
+		LinkedList<T, Allocator> m_LinkedList;
 
 	public:
 		/// <summary>
@@ -28,9 +28,10 @@ namespace collections {
 
 			Comp c = Comp();
 			//highest priority first
-			int i;
-			for (i = 0; i < m_LinkedList.GetLength(); i++) {
-				if (c(val, *m_LinkedList[i])) {
+			//walk the nodes directly, indexing would restart from the head every time
+			int i = 0;
+			for (LinkedListNode<T>* node = m_LinkedList.GetHead(); node; node = node->next, i++) {
+				if (c(val, node->value)) {
 					break;
 				}
 			}
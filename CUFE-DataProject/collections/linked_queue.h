@@ -7,13 +7,13 @@ namespace collections {
 	/// <summary>
 	/// Queue implemented using a LinkedList
 	/// </summary>
-	template<typename T>
+	template<typename T, typename Allocator = LinkedNodePool<T>>
 	class LinkedQueue : public Queue<T> {
 	protected:
 		/// <summary>
 		/// The underlying linked list
 		/// </summary>
-		LinkedList<T> m_LinkedList;
+		LinkedList<T, Allocator> m_LinkedList;
 
 	public:
 		/// <summary>
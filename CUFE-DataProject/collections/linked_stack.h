@@ -4,13 +4,13 @@
 #include "linked_list.h"
 
 namespace collections {
-	template<typename T>
+	template<typename T, typename Allocator = LinkedNodePool<T>>
 	class LinkedStack : public Stack<T> {
 	private:
 		/// <summary>
 		/// The underlying linked list
 		/// </summary>
-		LinkedList<T> m_LinkedList;
+		LinkedList<T, Allocator> m_LinkedList;
 
 	public:
 		virtual void Push(T val) override {
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace collections {
+	/// <summary>
+	/// Slab allocator for objects of one type
+	/// <para>Objects live in chunks that are never moved, so addresses are stable. Freed slots are kept in a
+	/// free list, Create and Destroy are O(1). Release drops every chunk at once</para>
+	/// <para>Chunks start at 8 slots and double up to ChunkSize, so small pools stay small</para>
+	/// </summary>
+	template<typename T, int ChunkSize = 256>
+	class ObjectPool {
+	private:
+		/// A free slot holds the next free slot, a used slot holds the object
+		union Slot {
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		/// Chunk header, the slots follow it
+		struct Chunk {
+			Chunk* next;
+			Slot* slots;
+		};
+
+		/// <summary>
+		/// Every chunk allocated so far, most recent first
+		/// </summary>
+		Chunk* m_Chunks;
+
+		/// <summary>
+		/// Head of the free slot list
+		/// </summary>
+		Slot* m_FreeSlots;
+
+		/// <summary>
+		/// Slots of the most recent chunk that were handed out
+		/// </summary>
+		int m_ChunkUsed;
+
+		/// <summary>
+		/// Slots in the most recent chunk
+		/// </summary>
+		int m_ChunkSlots;
+
+		int m_Capacity;
+		int m_LiveCount;
+
+		/// Size of the first chunk
+		static constexpr int FirstChunkSize() {
+			return ChunkSize < 8 ? ChunkSize : 8;
+		}
+
+		void* Allocate() {
+			Slot* slot;
+			if (m_FreeSlots != 0) {
+				slot = m_FreeSlots;
+				m_FreeSlots = slot->next;
+			}
+			else {
+				if (m_Chunks == 0 || m_ChunkUsed == m_ChunkSlots) {
+					//double the chunk size until ChunkSize
+					int slots = m_Chunks == 0 ? FirstChunkSize() : m_ChunkSlots * 2;
+					if (slots > ChunkSize) slots = ChunkSize;
+
+					//header and slots in one block, header is padded to the slot alignment
+					constexpr size_t headerSize = (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+					Chunk* chunk = (Chunk*)operator new(headerSize + sizeof(Slot) * slots);
+					chunk->next = m_Chunks;
+					chunk->slots = (Slot*)((unsigned char*)chunk + headerSize);
+
+					m_Chunks = chunk;
+					m_ChunkUsed = 0;
+					m_ChunkSlots = slots;
+					m_Capacity += slots;
+				}
+
+				slot = &m_Chunks->slots[m_ChunkUsed++];
+			}
+
+			m_LiveCount++;
+			return slot->storage;
+		}
+
+		void Free(void* ptr) {
+			Slot* slot = (Slot*)ptr;
+			slot->next = m_FreeSlots;
+			m_FreeSlots = slot;
+
+			m_LiveCount--;
+		}
+
+	public:
+		ObjectPool() : m_Chunks(0), m_FreeSlots(0), m_ChunkUsed(0), m_ChunkSlots(0), m_Capacity(0), m_LiveCount(0) {
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		~ObjectPool() {
+			Release();
+		}
+
+		/// <summary>
+		/// Constructs an object in a free slot
+		/// </summary>
+		template<typename... Args>
+		T* Create(Args&&... args) {
+			return new(Allocate()) T(_STD forward<Args>(args)...);
+		}
+
+		/// <summary>
+		/// Destructs an object created by this pool and returns its slot
+		/// </summary>
+		void Destroy(T* obj) {
+			if (obj == 0) return;
+
+			obj->~T();
+			Free(obj);
+		}
+
+		/// <summary>
+		/// Frees every chunk, objects that are still alive are dropped without running their destructors
+		/// </summary>
+		void Release() {
+			while (m_Chunks != 0) {
+				Chunk* next = m_Chunks->next;
+				operator delete(m_Chunks);
+
+				m_Chunks = next;
+			}
+
+			m_FreeSlots = 0;
+			m_ChunkUsed = 0;
+			m_ChunkSlots = 0;
+			m_Capacity = 0;
+			m_LiveCount = 0;
+		}
+
+		/// <summary>
+		/// Number of objects currently alive
+		/// </summary>
+		int GetLiveCount() {
+			return m_LiveCount;
+		}
+
+		/// <summary>
+		/// Number of slots allocated so far
+		/// </summary>
+		int GetCapacity() {
+			return m_Capacity;
+		}
+	};
+
+	/// <summary>
+	/// Allocator with the ObjectPool interface that goes straight to the heap
+	/// </summary>
+	template<typename T>
+	class HeapAllocator {
+	public:
+		template<typename... Args>
+		T* Create(Args&&... args) {
+			return new T(_STD forward<Args>(args)...);
+		}
+
+		void Destroy(T* obj) {
+			delete obj;
+		}
+	};
+}
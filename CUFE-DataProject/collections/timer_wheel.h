@@ -0,0 +1,296 @@
+#pragma once
+
+#include "intrusive_list.h"
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+// Slots per level, a level covers TIMER_WHEEL_SLOT_BITS more bits of the deadline
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+
+// Enough levels for any non negative int
+#define TIMER_WHEEL_LEVELS ((31 + TIMER_WHEEL_SLOT_BITS - 1) / TIMER_WHEEL_SLOT_BITS)
+
+namespace collections {
+	/// <summary>
+	/// State embedded in an element of a TimerWheel
+	/// </summary>
+	template<typename T>
+	struct TimerWheelHook {
+		/// <summary>
+		/// Links of the slot or expired list the timer is in
+		/// </summary>
+		IntrusiveListHook<T> link;
+
+		/// <summary>
+		/// Tick the timer expires at
+		/// </summary>
+		int deadline;
+	};
+
+	/// <summary>
+	/// Hierarchical timing wheel of intrusive timers keyed by an absolute tick
+	/// <para>HookAccessor()(T*) returns the TimerWheelHook of an element. Level l slots are 2^(l * TIMER_WHEEL_SLOT_BITS) ticks wide,
+	/// a timer moves down a level whenever time enters its slot and lands in the expired list at its deadline.
+	/// Scheduling and cancelling are O(1), advancing jumps over empty slots</para>
+	/// </summary>
+	template<typename T, typename HookAccessor>
+	class TimerWheel {
+	private:
+		struct LinkAccessor {
+			IntrusiveListHook<T>* operator()(T* element) {
+				return &Hook(element)->link;
+			}
+		};
+
+		typedef IntrusiveList<T, LinkAccessor> TimerList;
+
+		/// <summary>
+		/// Timers per level and slot
+		/// </summary>
+		TimerList m_Slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+
+		/// <summary>
+		/// Non empty slots per level, bit i is set if slot i has timers
+		/// </summary>
+		uint64_t m_Occupied[TIMER_WHEEL_LEVELS];
+
+		/// <summary>
+		/// Timers whose deadline has been reached and that are not consumed yet
+		/// </summary>
+		TimerList m_Expired;
+
+		/// <summary>
+		/// Current tick
+		/// </summary>
+		int m_Now;
+
+		int m_Count;
+
+		static TimerWheelHook<T>* Hook(T* element) {
+			HookAccessor accessor = HookAccessor();
+			return accessor(element);
+		}
+
+		/// Slot digit of a tick at a level
+		static int GetDigit(long long tick, int level) {
+			return (int)(tick >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOTS - 1);
+		}
+
+		/// Index of the lowest set bit, bits must not be 0
+		static int GetLowestBit(uint64_t bits) {
+			int index = 0;
+			while ((bits & 1) == 0) {
+				bits >>= 1;
+				index++;
+			}
+
+			return index;
+		}
+
+		/// Links a timer in the slot of its deadline, or in the expired list if it is due
+		void Link(T* element) {
+			int deadline = Hook(element)->deadline;
+			if (deadline <= m_Now) {
+				m_Expired.PushBack(element);
+				return;
+			}
+
+			//level of the highest digit the deadline differs from now in, everything above it is shared
+			int level = TIMER_WHEEL_LEVELS - 1;
+			while (level > 0 && GetDigit(deadline, level) == GetDigit(m_Now, level)) {
+				level--;
+			}
+
+			int slot = GetDigit(deadline, level);
+			m_Slots[level][slot].PushBack(element);
+			m_Occupied[level] |= 1ull << slot;
+		}
+
+		/// Unlinks a timer from wherever it is linked
+		void Unlink(T* element) {
+			TimerList* list = (TimerList*)Hook(element)->link.list;
+			list->Remove(element);
+
+			if (list != &m_Expired && list->IsEmpty()) {
+				int index = (int)(list - &m_Slots[0][0]);
+				m_Occupied[index / TIMER_WHEEL_SLOTS] &= ~(1ull << (index % TIMER_WHEEL_SLOTS));
+			}
+		}
+
+		/// <summary>
+		/// Tick the first non empty slot of a level is reached at, LLONG_MAX if the level is empty
+		/// <para>Occupied slots always lie after the current digit of their level</para>
+		/// </summary>
+		long long GetSlotTime(int level) {
+			if (m_Occupied[level] == 0) return LLONG_MAX;
+
+			int slot = GetLowestBit(m_Occupied[level]);
+			int shift = level * TIMER_WHEEL_SLOT_BITS;
+
+			//keep the digits above the level, replace the rest with the slot
+			long long prefix = ((long long)m_Now >> (shift + TIMER_WHEEL_SLOT_BITS)) << (shift + TIMER_WHEEL_SLOT_BITS);
+			return prefix + ((long long)slot << shift);
+		}
+
+	public:
+		TimerWheel() : m_Now(0), m_Count(0) {
+			memset(m_Occupied, 0, sizeof(m_Occupied));
+		}
+
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel& operator=(const TimerWheel&) = delete;
+
+		/// <summary>
+		/// Returns the current tick
+		/// </summary>
+		int GetTime() {
+			return m_Now;
+		}
+
+		/// <summary>
+		/// Number of pending and expired timers
+		/// </summary>
+		int GetLength() {
+			return m_Count;
+		}
+
+		/// <summary>
+		/// (Re)schedules a timer to expire at deadline, a deadline that is not after the current tick expires right away
+		/// </summary>
+		void Schedule(T* element, int deadline) {
+			Cancel(element);
+
+			Hook(element)->deadline = deadline;
+			Link(element);
+
+			m_Count++;
+		}
+
+		/// <summary>
+		/// Removes a pending or expired timer, false if it isnt scheduled
+		/// </summary>
+		bool Cancel(T* element) {
+			if (!IsScheduled(element)) return false;
+
+			Unlink(element);
+			m_Count--;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Is the timer pending or expired?
+		/// </summary>
+		bool IsScheduled(T* element) {
+			return Hook(element)->link.list != 0;
+		}
+
+		/// <summary>
+		/// Has the timer reached its deadline without being cancelled since?
+		/// </summary>
+		bool IsExpired(T* element) {
+			return m_Expired.Contains(element);
+		}
+
+		/// <summary>
+		/// Returns the deadline of a scheduled timer
+		/// </summary>
+		int GetDeadline(T* element) {
+			return Hook(element)->deadline;
+		}
+
+		/// <summary>
+		/// Earliest deadline of the scheduled timers, the current tick if any expired, INT_MAX if there are none
+		/// </summary>
+		int GetNextDeadline() {
+			if (!m_Expired.IsEmpty()) return m_Now;
+
+			//the first non empty slot of every level holds the earliest deadlines of that level
+			int next = INT_MAX;
+			for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+				if (m_Occupied[level] == 0) continue;
+
+				TimerList* list = &m_Slots[level][GetLowestBit(m_Occupied[level])];
+				for (T* element = list->GetHead(); element; element = list->GetNext(element)) {
+					if (Hook(element)->deadline < next) {
+						next = Hook(element)->deadline;
+					}
+				}
+			}
+
+			return next;
+		}
+
+		/// <summary>
+		/// Moves time forward to now, timers due by then move to the expired list
+		/// <para>Only the ticks at which a non empty slot is reached are visited</para>
+		/// </summary>
+		void Advance(int now) {
+			while (m_Now < now) {
+				long long next = LLONG_MAX;
+				for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+					long long time = GetSlotTime(level);
+					if (time < next) {
+						next = time;
+					}
+				}
+
+				if (next > now) {
+					m_Now = now;
+					return;
+				}
+
+				m_Now = (int)next;
+
+				//higher levels first, their timers may move down into a slot reached at this very tick
+				for (int level = TIMER_WHEEL_LEVELS - 1; level >= 0; level--) {
+					if (GetSlotTime(level) != next) continue;
+
+					int slot = GetDigit(next, level);
+					TimerList* list = &m_Slots[level][slot];
+					m_Occupied[level] &= ~(1ull << slot);
+
+					T* element;
+					while (list->Dequeue(&element)) {
+						Link(element);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Attempts to remove an expired timer, oldest first
+		/// </summary>
+		bool PopExpired(T** element = 0) {
+			T* expired;
+			if (!m_Expired.Dequeue(&expired)) return false;
+
+			m_Count--;
+
+			if (element) {
+				*element = expired;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Removes every timer, time is kept
+		/// </summary>
+		void Clear() {
+			for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+				for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+					m_Slots[level][slot].Clear();
+				}
+
+				m_Occupied[level] = 0;
+			}
+
+			m_Expired.Clear();
+			m_Count = 0;
+		}
+	};
+}
@@ -19,11 +19,38 @@ typedef unsigned int uint32_t;
 
 #define LOG_WIDTH 60
 
+// Number of log lines kept for the log view
+#define LOG_MAX_MESSAGES 50
+
+// Log levels, must match core::LogLevel
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_ERROR 4
+
+// Lines below this level are compiled out, define it through the compiler (/D LOG_COMPILE_LEVEL=n) to override
+#ifndef LOG_COMPILE_LEVEL
+#ifdef _DEBUG
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#else
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+// Headless batch build, strips the console UI and every Windows dependency
+// define it through the compiler (/D HEADLESS) to build the batch driver
+//#define HEADLESS
+
 //required by swprintf
 #define _CRT_NON_CONFORMING_SWPRINTFS
 
 #define BOOL_TO_WSTR(b) (b ? L"TRUE" : L"FALSE")
 
+// Number of NEW processes and sigkills kept in memory ahead of the simulation
+// the rest of the input file is streamed in as they are consumed
+#define STREAM_LOOKAHEAD 64
+
 #define OVERRIDE_OVERHEAT_DELAY
 #define OVERHEAT_DELAY 10
 
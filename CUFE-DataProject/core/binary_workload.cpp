@@ -0,0 +1,193 @@
+#include "binary_workload.h"
+#include "../utils/output_file.h"
+
+#include <fstream>
+
+namespace core {
+	/// Opens a deserializer on src and reads the parameters
+	static bool OpenSource(Deserializer& deserializer, DeserializerData& data, _STD wstring& error) {
+		if (!deserializer.Deserialize(data)) {
+			error = deserializer.GetError();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ConvertToBinaryWorkload(_STD wstring& src, _STD wstring& dst, _STD wstring& error) {
+		DeserializerData data;
+
+		//first pass writes the process records, second pass writes the io pairs and sigkills
+		Deserializer recordPass(src);
+		if (!OpenSource(recordPass, data, error)) return false;
+
+		_STD ofstream file;
+		if (!_UTIL OpenOutputFile(file, dst, _STD ios::out | _STD ios::binary)) {
+			error = L"cannot open output file";
+			return false;
+		}
+
+		BinaryWorkloadHeader header;
+		memset(&header, 0, sizeof(BinaryWorkloadHeader));
+		memcpy(header.magic, BINARY_WORKLOAD_MAGIC, 4);
+
+		header.version = BINARY_WORKLOAD_VERSION;
+		header.num_processors_fcfs = data.num_processors_fcfs;
+		header.num_processors_sjf = data.num_processors_sjf;
+		header.num_processors_rr = data.num_processors_rr;
+		header.num_processors_edf = data.num_processors_edf;
+		header.rr_timeslice = data.rr_timeslice;
+		header.rtf = data.rtf;
+		header.maxw = data.maxw;
+		header.stl = data.stl;
+		header.fork_prob = data.fork_prob;
+		header.overheat_delay = data.overheat_delay;
+
+		//counts are patched once known
+		file.write((const char*)&header, sizeof(BinaryWorkloadHeader));
+
+		//one slot is reused for every process
+		ProcessPool pool;
+
+		Process* proc;
+		while (recordPass.ReadProcess(&proc, &pool)) {
+			BinaryProcessRecord record = {
+				proc->GetArrivalTime(),
+				proc->GetPID(),
+				proc->GetCPUTime(),
+				proc->GetDeadline(),
+				header.io_count,
+				0
+			};
+
+			while (proc->HasAnyIOEvent()) {
+				proc->GetIOData();
+				record.io_count++;
+			}
+
+			header.io_count += record.io_count;
+			header.proc_count++;
+
+			file.write((const char*)&record, sizeof(BinaryProcessRecord));
+
+			pool.Destroy(proc);
+		}
+
+		if (!recordPass.GetError().empty()) {
+			error = recordPass.GetError();
+			return false;
+		}
+
+		Deserializer ioPass(src);
+		if (!OpenSource(ioPass, data, error)) return false;
+
+		while (ioPass.ReadProcess(&proc, &pool)) {
+			while (proc->HasAnyIOEvent()) {
+				ProcessIOData ioData = proc->GetIOData();
+				file.write((const char*)&ioData, sizeof(ProcessIOData));
+			}
+
+			pool.Destroy(proc);
+		}
+
+		SigkillTimeInfo sigkill;
+		while (ioPass.ReadSigkill(&sigkill)) {
+			file.write((const char*)&sigkill, sizeof(SigkillTimeInfo));
+			header.sigkill_count++;
+		}
+
+		if (!ioPass.GetError().empty()) {
+			error = ioPass.GetError();
+			return false;
+		}
+
+		//patch header
+		file.seekp(0);
+		file.write((const char*)&header, sizeof(BinaryWorkloadHeader));
+
+		if (!file.good()) {
+			error = L"failed to write output file";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ConvertToTextWorkload(_STD wstring& src, _STD wstring& dst, _STD wstring& error) {
+		DeserializerData data;
+
+		Deserializer deserializer(src);
+		if (!OpenSource(deserializer, data, error)) return false;
+
+		_STD ofstream file;
+		if (!_UTIL OpenOutputFile(file, dst, _STD ios::out)) {
+			error = L"cannot open output file";
+			return false;
+		}
+
+		//same format as deserializer
+		file << data.num_processors_fcfs << '\t'
+			<< data.num_processors_sjf << '\t'
+			<< data.num_processors_rr << '\t'
+			<< data.num_processors_edf << '\n';
+
+		file << data.rr_timeslice << '\n';
+
+		file << data.rtf << '\t'
+			<< data.maxw << '\t'
+			<< data.stl << '\t'
+			<< data.fork_prob << '\t'
+			<< data.overheat_delay << '\n';
+
+		file << data.proc_count << '\n';
+
+		ProcessPool pool;
+
+		Process* proc;
+		while (deserializer.ReadProcess(&proc, &pool)) {
+			file << proc->GetArrivalTime() << '\t'
+				<< proc->GetPID() << '\t'
+				<< proc->GetCPUTime() << '\t'
+				<< proc->GetDeadline() << '\t';
+
+			//count io pairs, then write them
+			_COLLECTION LinkedQueue<ProcessIOData> ioQueue;
+			while (proc->HasAnyIOEvent()) {
+				ioQueue.Enqueue(proc->GetIOData());
+			}
+
+			file << ioQueue.GetLength() << '\t';
+
+			ProcessIOData ioData;
+			while (ioQueue.Dequeue(&ioData)) {
+				file << '(' << ioData.request_time << ',' << ioData.duration << ')';
+
+				if (!ioQueue.IsEmpty()) {
+					file << ',';
+				}
+			}
+
+			file << '\n';
+
+			pool.Destroy(proc);
+		}
+
+		SigkillTimeInfo sigkill;
+		while (deserializer.ReadSigkill(&sigkill)) {
+			file << sigkill.time << '\t'
+				<< sigkill.proc_pid << '\n';
+		}
+
+		if (!deserializer.GetError().empty()) {
+			error = deserializer.GetError();
+			return false;
+		}
+
+		if (!file.good()) {
+			error = L"failed to write output file";
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../common.h"
+#include "process.h"
+#include "deserializer.h"
+
+#include <string>
+
+// Binary workload file, little endian
+// header | process records | io pairs | sigkills
+#define BINARY_WORKLOAD_MAGIC "SCHB"
+#define BINARY_WORKLOAD_VERSION 1
+
+namespace core {
+	/// <summary>
+	/// Fixed size header of a binary workload file
+	/// </summary>
+	struct BinaryWorkloadHeader {
+		// BINARY_WORKLOAD_MAGIC, not null terminated
+		char magic[4];
+
+		// BINARY_WORKLOAD_VERSION
+		uint32_t version;
+
+		//same parameters as DeserializerData
+		int num_processors_fcfs;
+		int num_processors_sjf;
+		int num_processors_rr;
+		int num_processors_edf;
+		int rr_timeslice;
+		int rtf;
+		int maxw;
+		int stl;
+		int fork_prob;
+		int overheat_delay;
+
+		// Number of process records
+		int proc_count;
+
+		// Number of io pairs, shared by all processes
+		int io_count;
+
+		// Number of sigkills
+		int sigkill_count;
+
+		// Always zero, keeps the header 8 byte aligned
+		int reserved;
+	};
+
+	/// <summary>
+	/// A process in a binary workload file
+	/// </summary>
+	struct BinaryProcessRecord {
+		int arrival_time;
+		int pid;
+		int cpu_time;
+		int deadline;
+
+		// Index of the first io pair of the process in the io pair table
+		int io_first;
+
+		// Number of io pairs of the process
+		int io_count;
+
+		bool operator==(BinaryProcessRecord& other) {
+			return memcmp(this, &other, sizeof(BinaryProcessRecord)) == 0;
+		}
+	};
+
+	//records are mapped straight from the file
+	static_assert(sizeof(BinaryWorkloadHeader) == 64, "BinaryWorkloadHeader must be packed");
+	static_assert(sizeof(BinaryProcessRecord) == 24, "BinaryProcessRecord must be packed");
+	static_assert(sizeof(ProcessIOData) == 8, "ProcessIOData must be packed");
+	static_assert(sizeof(SigkillTimeInfo) == 8, "SigkillTimeInfo must be packed");
+
+	/// <summary>
+	/// Converts a workload file (text or binary) to the binary format, error is set on failure
+	/// </summary>
+	bool ConvertToBinaryWorkload(_STD wstring& src, _STD wstring& dst, _STD wstring& error);
+
+	/// <summary>
+	/// Converts a workload file (text or binary) to the text format, error is set on failure
+	/// </summary>
+	bool ConvertToTextWorkload(_STD wstring& src, _STD wstring& dst, _STD wstring& error);
+}
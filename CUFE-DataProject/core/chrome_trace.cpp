@@ -0,0 +1,211 @@
+#include "chrome_trace.h"
+#include "processor.h"
+#include "../utils/output_file.h"
+
+namespace core {
+	ChromeTrace::ChromeTrace() : m_Open(false), m_HasEvents(false), m_IOSlice({ -1, 0 }), m_NextFlowID(0), m_LastTimestep(0) {
+	}
+
+	ChromeTrace::~ChromeTrace() {
+		Close();
+	}
+
+	bool ChromeTrace::Open(_STD wstring& filename, _STD wstring& error) {
+		Close();
+
+		if (!_UTIL OpenOutputFile(m_File, filename, _STD ios::out)) {
+			error = L"cannot open chrome trace file";
+			return false;
+		}
+
+		m_Open = true;
+		m_HasEvents = false;
+		m_RunSlices.Clear();
+		m_IOSlice = { -1, 0 };
+		m_NextFlowID = 0;
+		m_LastTimestep = 0;
+
+		//json array format, viewers also accept it without the closing bracket if we never get to close
+		m_File << "[\n";
+
+		BeginEvent() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Scheduler\"}}";
+		BeginEvent() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"IO\"}}";
+
+		return true;
+	}
+
+	void ChromeTrace::Close() {
+		if (!m_Open) return;
+
+		//end whatever is still open
+		for (int i = 0; i < m_RunSlices.GetLength(); i++) {
+			EndRunSlice(i, -1, m_LastTimestep);
+		}
+
+		if (m_IOSlice.pid != -1) {
+			WriteSlice(0, "IO", m_IOSlice.pid, m_IOSlice.start, m_LastTimestep);
+			m_IOSlice.pid = -1;
+		}
+
+		m_File << "\n]\n";
+		m_File.close();
+
+		m_Open = false;
+	}
+
+	_STD ofstream& ChromeTrace::BeginEvent() {
+		if (m_HasEvents) {
+			m_File << ",\n";
+		}
+
+		m_HasEvents = true;
+		return m_File;
+	}
+
+	int ChromeTrace::GetTrackID(int processor) {
+		return processor + 1;
+	}
+
+	void ChromeTrace::EnsureTrack(int processor) {
+		while (m_RunSlices.GetLength() <= processor) {
+			m_RunSlices.Add({ -1, 0 });
+		}
+	}
+
+	void ChromeTrace::WriteSlice(int track, const char* name, int pid, int start, int end) {
+		BeginEvent() << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+			<< ",\"ts\":" << (long long)start * CHROME_TRACE_TIMESTEP_US
+			<< ",\"dur\":" << (long long)(end - start) * CHROME_TRACE_TIMESTEP_US
+			<< ",\"args\":{\"pid\":" << pid << "}}";
+	}
+
+	void ChromeTrace::WriteInstant(int track, const char* name, int pid, int timestep) {
+		BeginEvent() << "{\"name\":\"" << name << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << track
+			<< ",\"ts\":" << (long long)timestep * CHROME_TRACE_TIMESTEP_US
+			<< ",\"args\":{\"pid\":" << pid << "}}";
+	}
+
+	void ChromeTrace::WriteFlow(int fromTrack, int toTrack, const char* name, int pid, int timestep) {
+		long long ts = (long long)timestep * CHROME_TRACE_TIMESTEP_US;
+		int id = m_NextFlowID++;
+
+		BeginEvent() << "{\"name\":\"" << name << "\",\"cat\":\"" << name << "\",\"ph\":\"s\",\"id\":" << id
+			<< ",\"pid\":1,\"tid\":" << fromTrack << ",\"ts\":" << ts << ",\"args\":{\"pid\":" << pid << "}}";
+		BeginEvent() << "{\"name\":\"" << name << "\",\"cat\":\"" << name << "\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << id
+			<< ",\"pid\":1,\"tid\":" << toTrack << ",\"ts\":" << ts << "}";
+	}
+
+	void ChromeTrace::EndRunSlice(int processor, int pid, int timestep) {
+		if (processor < 0 || processor >= m_RunSlices.GetLength()) return;
+
+		OpenSlice* slice = m_RunSlices[processor];
+		if (slice->pid == -1 || (pid != -1 && slice->pid != pid)) return;
+
+		_STD string name = "P" + _STD to_string(slice->pid);
+		WriteSlice(GetTrackID(processor), name.c_str(), slice->pid, slice->start, timestep);
+
+		slice->pid = -1;
+	}
+
+	void ChromeTrace::AddProcessorTrack(Processor* processor) {
+		if (!m_Open) return;
+
+		int id = processor->GetID();
+		EnsureTrack(id);
+
+		//names are plain ascii
+		_STD wstring type = ProcessorTypeToWString(processor->GetProcessorType());
+		_STD string name = "P" + _STD to_string(id + 1) + " (" + _STD string(type.begin(), type.end()) + ")";
+
+		BeginEvent() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GetTrackID(id)
+			<< ",\"args\":{\"name\":\"" << name << "\"}}";
+		BeginEvent() << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GetTrackID(id)
+			<< ",\"args\":{\"sort_index\":" << GetTrackID(id) << "}}";
+	}
+
+	void ChromeTrace::Write(int timestep, TraceEventType type, int pid, int processor, int arg0, int) {
+		if (!m_Open) return;
+
+		m_LastTimestep = timestep;
+
+		if (processor >= 0) {
+			EnsureTrack(processor);
+		}
+
+		switch (type) {
+		case TraceEventType::Run:
+			//a processor runs one process at a time
+			EndRunSlice(processor, -1, timestep);
+
+			m_RunSlices[processor]->pid = pid;
+			m_RunSlices[processor]->start = timestep;
+			break;
+
+		case TraceEventType::Block:
+			EndRunSlice(processor, pid, timestep);
+
+			//waits in BLK until it gets the IO mutex
+			BeginEvent() << "{\"name\":\"BLK\",\"cat\":\"BLK\",\"ph\":\"b\",\"id\":" << pid
+				<< ",\"pid\":1,\"ts\":" << (long long)timestep * CHROME_TRACE_TIMESTEP_US << "}";
+			break;
+
+		case TraceEventType::IOGrant:
+			BeginEvent() << "{\"name\":\"BLK\",\"cat\":\"BLK\",\"ph\":\"e\",\"id\":" << pid
+				<< ",\"pid\":1,\"ts\":" << (long long)timestep * CHROME_TRACE_TIMESTEP_US << "}";
+
+			m_IOSlice = { pid, timestep };
+			break;
+
+		case TraceEventType::IORelease:
+			if (m_IOSlice.pid == pid) {
+				WriteSlice(0, "IO", pid, m_IOSlice.start, timestep);
+				m_IOSlice.pid = -1;
+			}
+			break;
+
+		case TraceEventType::Preemption:
+		case TraceEventType::Termination:
+			EndRunSlice(processor, pid, timestep);
+			break;
+
+		case TraceEventType::Migration:
+			EndRunSlice(processor, pid, timestep);
+
+			if (processor >= 0 && arg0 >= 0) {
+				WriteFlow(GetTrackID(processor), GetTrackID(arg0), "MIGRATION", pid, timestep);
+			}
+			break;
+
+		case TraceEventType::Steal:
+			if (processor >= 0 && arg0 >= 0) {
+				WriteFlow(GetTrackID(processor), GetTrackID(arg0), "STEAL", pid, timestep);
+			}
+			break;
+
+		case TraceEventType::Fork:
+			if (processor >= 0) {
+				WriteInstant(GetTrackID(processor), "FORK", pid, timestep);
+			}
+			break;
+
+		case TraceEventType::Kill:
+			if (processor >= 0) {
+				WriteInstant(GetTrackID(processor), "KILL", pid, timestep);
+			}
+			break;
+
+		case TraceEventType::Overheat:
+			//running process is migrated away, the processor stays STOP for the overheat delay
+			EndRunSlice(processor, -1, timestep);
+			WriteSlice(GetTrackID(processor), "STOP", -1, timestep, timestep + arg0);
+			break;
+
+		case TraceEventType::Arrival:
+			//not drawn, the process shows up once it runs
+			break;
+
+		default:
+			break;
+		}
+	}
+}
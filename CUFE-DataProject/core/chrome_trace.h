@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../common.h"
+#include "../collections/array_list.h"
+#include "event_trace.h"
+
+#include <string>
+#include <fstream>
+
+// Trace viewer time of a timestep in microseconds, a timestep reads as a millisecond
+#define CHROME_TRACE_TIMESTEP_US 1000
+
+namespace core {
+	class Processor;
+
+	/// <summary>
+	/// Streams the simulated schedule as Chrome Trace Event JSON, viewable in Perfetto or chrome://tracing
+	/// <para>Every processor is a track, RUN intervals are slices, IO intervals are slices on an IO track,
+	/// BLK waits are async slices, STOP periods are slices and migrations/steals are flow arrows between tracks</para>
+	/// <para>A slice is written as soon as it ends, nothing is held back apart from the open slices</para>
+	/// </summary>
+	class ChromeTrace {
+	private:
+		/// A slice that has started but not ended yet
+		struct OpenSlice {
+			// Process id, -1 if no slice is open
+			int pid;
+
+			// Timestep of the start
+			int start;
+
+			bool operator==(OpenSlice& other) {
+				return pid == other.pid && start == other.start;
+			}
+		};
+
+		/// <summary>
+		/// The json file
+		/// </summary>
+		_STD ofstream m_File;
+
+		/// <summary>
+		/// Is the trace being written?
+		/// </summary>
+		bool m_Open;
+
+		/// <summary>
+		/// Has an event been written yet? events are comma separated
+		/// </summary>
+		bool m_HasEvents;
+
+		/// <summary>
+		/// Running slice per processor track
+		/// </summary>
+		_COLLECTION ArrayList<OpenSlice> m_RunSlices;
+
+		/// <summary>
+		/// Process owning the IO mutex
+		/// </summary>
+		OpenSlice m_IOSlice;
+
+		/// <summary>
+		/// Id of the next flow arrow
+		/// </summary>
+		int m_NextFlowID;
+
+		/// <summary>
+		/// Latest timestep seen, open slices end there when the trace is closed
+		/// </summary>
+		int m_LastTimestep;
+
+		/// Starts a new event, returns the stream to write its fields into
+		_STD ofstream& BeginEvent();
+
+		/// Track of a processor, the IO track is 0
+		static int GetTrackID(int processor);
+
+		/// Makes sure a processor has a running slice entry
+		void EnsureTrack(int processor);
+
+		/// Writes a complete slice
+		void WriteSlice(int track, const char* name, int pid, int start, int end);
+
+		/// Writes an instant event on a track
+		void WriteInstant(int track, const char* name, int pid, int timestep);
+
+		/// Writes a flow arrow between two tracks
+		void WriteFlow(int fromTrack, int toTrack, const char* name, int pid, int timestep);
+
+		/// Ends the running slice of a processor, pid -1 ends any
+		void EndRunSlice(int processor, int pid, int timestep);
+
+	public:
+		ChromeTrace();
+		~ChromeTrace();
+
+		ChromeTrace(const ChromeTrace&) = delete;
+		ChromeTrace& operator=(const ChromeTrace&) = delete;
+
+		/// <summary>
+		/// Creates the json file, error is set on failure
+		/// </summary>
+		bool Open(_STD wstring& filename, _STD wstring& error);
+
+		/// <summary>
+		/// Ends the open slices and closes the file
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// Is the trace being written?
+		/// </summary>
+		bool IsOpen() {
+			return m_Open;
+		}
+
+		/// <summary>
+		/// Names the track of a processor
+		/// </summary>
+		void AddProcessorTrack(Processor* processor);
+
+		/// <summary>
+		/// Adds a scheduler event to the timeline, same arguments as EventTrace::Write
+		/// </summary>
+		void Write(int timestep, TraceEventType type, int pid, int processor, int arg0 = 0, int arg1 = 0);
+	};
+}
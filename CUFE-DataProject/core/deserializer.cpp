@@ -1,136 +1,587 @@
 #include "deserializer.h"
+#include "binary_workload.h"
+#include "../utils/worker_pool.h"
+
+#include <climits>
+#include <algorithm>
 
 namespace core {
-    Deserializer::Deserializer(_STD wstring& path) : m_Processes(0), m_Sigkills(0), m_SigkillCount(0) {
-        m_Stream.open(path, _STD ios::in);
+    /// <summary>
+    /// A range of whole lines of the process/sigkill section, parsed by a worker thread
+    /// </summary>
+    struct DeserializerChunk {
+        const char* begin;
+        const char* end;
+
+        // Tables of the chunk, io_first is relative to the chunk io table
+        _COLLECTION ArrayList<BinaryProcessRecord> processes;
+        _COLLECTION ArrayList<ProcessIOData> io_data;
+        _COLLECTION ArrayList<SigkillTimeInfo> sigkills;
+
+        // Parse error, empty if none
+        _STD wstring error;
+    };
+
+    Deserializer::Deserializer(_STD wstring& path, int loadThreads) : m_ProcessCount(0), m_ProcessesRead(0), m_SigkillCount(0),
+        m_Binary(false), m_LoadThreads(loadThreads), m_ProcessTable(0), m_IODataTable(0), m_SigkillTable(0), m_IODataTableCount(0), m_SigkillTableCount(0),
+        m_ParsedProcesses(0), m_ParsedIOData(0), m_ParsedSigkills(0) {
+        m_File.Open(path);
+
+        //binary workloads start with the magic
+        m_Binary = m_File.GetSize() >= 4 && memcmp(m_File.GetData(), BINARY_WORKLOAD_MAGIC, 4) == 0;
+
+        //both cursors start at the beginning of the file
+        m_ProcessCursor.pos = m_File.GetData();
+        m_ProcessCursor.end = m_File.GetData() + m_File.GetSize();
+        m_ProcessCursor.line = 1;
+        m_ProcessCursor.line_start = m_ProcessCursor.pos;
+        m_ProcessCursor.error = &m_Error;
+
+        m_SigkillCursor = m_ProcessCursor;
     }
 
     Deserializer::~Deserializer() {
-        //only delete parent array, dont delete the proccesses themselves
-        if (m_Processes != 0) {
-            delete[] m_Processes;
-        }
-
-        if (m_Sigkills != 0) {
-            delete[] m_Sigkills;
+        if (m_ParsedProcesses != 0) {
+            delete[] m_ParsedProcesses;
+            delete[] m_ParsedIOData;
+            delete[] m_ParsedSigkills;
         }
     }
 
     bool Deserializer::IsValid() {
-        return m_Stream.good();
+        return m_File.IsOpen();
     }
 
     int Deserializer::GetSigkillCount() {
         return m_SigkillCount;
     }
 
+    bool Deserializer::IsBinary() {
+        return m_Binary;
+    }
+
+    _STD wstring& Deserializer::GetError() {
+        return m_Error;
+    }
+
+    void Deserializer::SetError(TextCursor& cursor, const wchar_t* expected) {
+        //keep the first error only
+        if (!cursor.error->empty()) return;
+
+        _STD wstringstream stream;
+        stream << L"line " << cursor.line
+            << L", column " << (int)(cursor.pos - cursor.line_start) + 1
+            << L": expected " << expected;
+
+        if (cursor.pos >= cursor.end) {
+            stream << L", found end of file";
+        }
+
+        *cursor.error = stream.str();
+    }
+
+    bool Deserializer::SkipWhitespace(TextCursor& cursor) {
+        const char* pos = cursor.pos;
+
+        while (pos < cursor.end) {
+            char c = *pos;
+
+            if (c == '\n') {
+                cursor.line++;
+                cursor.line_start = pos + 1;
+            }
+            else if (c != ' ' && c != '\t' && c != '\r') {
+                break;
+            }
+
+            pos++;
+        }
+
+        cursor.pos = pos;
+        return pos < cursor.end;
+    }
+
+    bool Deserializer::ReadInt(TextCursor& cursor, int& val, const wchar_t* name) {
+        if (!SkipWhitespace(cursor)) {
+            SetError(cursor, name);
+            return false;
+        }
+
+        const char* pos = cursor.pos;
+
+        bool negative = *pos == '-';
+        if (negative) {
+            pos++;
+        }
+
+        //at least one digit
+        if (pos >= cursor.end || *pos < '0' || *pos > '9') {
+            SetError(cursor, name);
+            return false;
+        }
+
+        long long num = 0;
+        while (pos < cursor.end && *pos >= '0' && *pos <= '9') {
+            num = num * 10 + (*pos - '0');
+
+            if (num > INT_MAX) {
+                SetError(cursor, name);
+                return false;
+            }
+
+            pos++;
+        }
+
+        val = (int)(negative ? -num : num);
+        cursor.pos = pos;
+
+        return true;
+    }
+
+    bool Deserializer::ReadChar(TextCursor& cursor, char c) {
+        if (!SkipWhitespace(cursor) || *cursor.pos != c) {
+            wchar_t expected[] = { L'\'', (wchar_t)c, L'\'', 0 };
+            SetError(cursor, expected);
+            return false;
+        }
+
+        cursor.pos++;
+        return true;
+    }
+
+    bool Deserializer::ReadProcessFields(TextCursor& cursor, int& at, int& pid, int& ct, int& deadline, int& ioCount) {
+        if (!ReadInt(cursor, at, L"arrival time")) {
+            return false;
+        }
+
+        //the first update is at timestep 1, an earlier process would never arrive
+        if (at < 1) {
+            SetError(cursor, L"arrival time of atleast 1");
+            return false;
+        }
+
+        if (!ReadInt(cursor, pid, L"pid")
+            || !ReadInt(cursor, ct, L"cpu time")
+            || !ReadInt(cursor, deadline, L"deadline")
+            || !ReadInt(cursor, ioCount, L"io count")) {
+            return false;
+        }
+
+        if (ioCount < 0) {
+            SetError(cursor, L"non negative io count");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Deserializer::ReadIOPair(TextCursor& cursor, ProcessIOData& ioData, bool last) {
+        //read io data in the format of (x,y),(z, w)
+        return ReadChar(cursor, '(')
+            && ReadInt(cursor, ioData.request_time, L"io request time")
+            && ReadChar(cursor, ',')
+            && ReadInt(cursor, ioData.duration, L"io duration")
+            && ReadChar(cursor, ')')
+            && (last || ReadChar(cursor, ','));
+    }
+
     bool Deserializer::Deserialize(DeserializerData& data) {
         //zero out the data
         memset(&data, 0, sizeof(DeserializerData));
 
         //return false if file doesnt exist
         if (!IsValid()) {
+            m_Error = L"cannot open file";
             return false;
         }
 
-        //processors info
-        m_Stream >> data.num_processors_fcfs
-            >> data.num_processors_sjf
-            >> data.num_processors_rr
-            >> data.num_processors_edf;
+        if (m_Binary) {
+            return DeserializeBinary(data);
+        }
+
+        TextCursor& cursor = m_ProcessCursor;
+
+        bool success =
+            //processors info
+            ReadInt(cursor, data.num_processors_fcfs, L"number of FCFS processors")
+            && ReadInt(cursor, data.num_processors_sjf, L"number of SJF processors")
+            && ReadInt(cursor, data.num_processors_rr, L"number of RR processors")
+            && ReadInt(cursor, data.num_processors_edf, L"number of EDF processors")
 
-        m_Stream >> data.rr_timeslice;
+            && ReadInt(cursor, data.rr_timeslice, L"RR time slice")
 
-        //attributes
-        m_Stream >> data.rtf
-            >> data.maxw
-            >> data.stl
-            >> data.fork_prob
-            >> data.overheat_delay;
+            //attributes
+            && ReadInt(cursor, data.rtf, L"RTF")
+            && ReadInt(cursor, data.maxw, L"MaxW")
+            && ReadInt(cursor, data.stl, L"STL")
+            && ReadInt(cursor, data.fork_prob, L"fork probability")
+            && ReadInt(cursor, data.overheat_delay, L"overheat delay")
 
-        //process info
-        m_Stream >> data.proc_count;
+            //process info
+            && ReadInt(cursor, data.proc_count, L"process count");
 
-        //allocate proccesses array
-        if (m_Processes != 0) {
-            //delete old proc array if exists, but idealy deserialize should be called once
-            delete[] m_Processes;
+        if (!success) {
+            return false;
         }
 
-        m_Processes = new Process*[data.proc_count];
+        m_ProcessCount = data.proc_count;
+        m_ProcessesRead = 0;
+        m_SigkillCount = 0;
+
+        //parse everything up front, files that dont split into lines are streamed instead
+        if (m_LoadThreads > 1 && DeserializeParallel()) {
+            return true;
+        }
+
+        //sigkills come after the process section, skip it once without allocating any process
+        m_SigkillCursor = m_ProcessCursor;
+
+        int at, pid, ct, deadline, ioCount;
+        int lastAt = INT_MIN;
+        ProcessIOData ioData;
+        for (int i = 0; i < m_ProcessCount && success; i++) {
+            TextCursor lineStart = m_SigkillCursor;
+
+            success = ReadProcessFields(m_SigkillCursor, at, pid, ct, deadline, ioCount);
+
+            //scheduler expects the NEW queue sorted by AT, only a parallel load can sort it
+            if (success && at < lastAt) {
+                SkipWhitespace(lineStart);
+                SetError(lineStart, L"arrival times in ascending order (load with more threads to sort them)");
+                success = false;
+            }
+
+            lastAt = at;
+
+            for (int j = 0; j < ioCount && success; j++) {
+                success = ReadIOPair(m_SigkillCursor, ioData, j == ioCount - 1);
+            }
+        }
 
-        //read processes
-        for (int i = 0; i < data.proc_count; i++) {
-            int at;
-            int pid;
-            int ct;
-            int deadline;
-            int ioCount;
+        return success;
+    }
+
+    bool Deserializer::SkipToLineEnd(TextCursor& cursor) {
+        while (cursor.pos < cursor.end && (*cursor.pos == ' ' || *cursor.pos == '\t' || *cursor.pos == '\r')) {
+            cursor.pos++;
+        }
+
+        return cursor.pos >= cursor.end || *cursor.pos == '\n';
+    }
+
+    void Deserializer::ParseChunk(DeserializerChunk* chunk) {
+        TextCursor cursor = { chunk->begin, chunk->end, 1, chunk->begin, &chunk->error };
 
-            m_Stream >> at
-                >> pid
-                >> ct
-                >> deadline
-                >> ioCount;
+        while (SkipWhitespace(cursor)) {
+            //a line is either a process or a sigkill, both start with two ints
+            int first, second;
+            if (!ReadInt(cursor, first, L"arrival time") || !ReadInt(cursor, second, L"pid")) {
+                return;
+            }
+
+            if (SkipToLineEnd(cursor)) {
+                SigkillTimeInfo sigkill = { first, second };
+                chunk->sigkills.Add(sigkill);
+                continue;
+            }
 
-            //temporary alloc an array for io data
-            ProcessIOData* procIOData = new ProcessIOData[ioCount];
-            
-            //zero out the array
-            memset(procIOData, 0, sizeof(ProcessIOData) * ioCount);
+            //processes cant follow sigkills
+            if (chunk->sigkills.GetLength() > 0) {
+                SetError(cursor, L"end of line");
+                return;
+            }
+
+            if (first < 1) {
+                SetError(cursor, L"arrival time of atleast 1");
+                return;
+            }
 
-            //read io data in the format of (x,y),(z, w)
-            char tmp;
-            for (int j = 0; j < ioCount; j++) {
+            BinaryProcessRecord record;
+            record.arrival_time = first;
+            record.pid = second;
+            record.io_first = chunk->io_data.GetLength();
+
+            if (!ReadInt(cursor, record.cpu_time, L"cpu time")
+                || !ReadInt(cursor, record.deadline, L"deadline")
+                || !ReadInt(cursor, record.io_count, L"io count")) {
+                return;
+            }
+
+            if (record.io_count < 0) {
+                SetError(cursor, L"non negative io count");
+                return;
+            }
+
+            for (int j = 0; j < record.io_count; j++) {
                 ProcessIOData ioData;
+                if (!ReadIOPair(cursor, ioData, j == record.io_count - 1)) {
+                    return;
+                }
+
+                chunk->io_data.Add(ioData);
+            }
+
+            //one process per line
+            if (!SkipToLineEnd(cursor)) {
+                SetError(cursor, L"end of line");
+                return;
+            }
+
+            chunk->processes.Add(record);
+        }
+    }
+
+    bool Deserializer::DeserializeParallel() {
+        const char* begin = m_ProcessCursor.pos;
+        const char* end = m_ProcessCursor.end;
+
+        //a few chunks per thread, so a slow chunk doesnt hold the rest
+        int chunkCount = m_LoadThreads * 4;
+        DeserializerChunk** chunks = new DeserializerChunk*[chunkCount];
+
+        //split at newline boundaries
+        size_t chunkSize = (end - begin) / chunkCount + 1;
+        const char* chunkBegin = begin;
+        for (int i = 0; i < chunkCount; i++) {
+            const char* chunkEnd = chunkBegin + _STD min(chunkSize, (size_t)(end - chunkBegin));
+
+            const char* newline = (const char*)memchr(chunkEnd, '\n', end - chunkEnd);
+            chunkEnd = newline != 0 ? newline + 1 : end;
+
+            chunks[i] = new DeserializerChunk();
+            chunks[i]->begin = chunkBegin;
+            chunks[i]->end = chunkEnd;
+
+            chunkBegin = chunkEnd;
+        }
+
+        //workers start on contiguous runs of chunks and steal from each other once theirs are parsed
+        _UTIL WorkerPool pool;
+        pool.Start(m_LoadThreads);
+        pool.ParallelForEach(chunkCount, [&](int i) {
+            ParseChunk(chunks[i]);
+        });
+
+        //validate the layout, processes then sigkills
+        bool success = true;
+        int procCount = 0, ioCount = 0, sigkillCount = 0;
+        bool seenSigkills = false;
+        for (int i = 0; i < chunkCount && success; i++) {
+            DeserializerChunk* chunk = chunks[i];
+
+            success = chunk->error.empty() && (!seenSigkills || chunk->processes.GetLength() == 0);
+            seenSigkills = seenSigkills || chunk->sigkills.GetLength() > 0;
+
+            procCount += chunk->processes.GetLength();
+            ioCount += chunk->io_data.GetLength();
+            sigkillCount += chunk->sigkills.GetLength();
+        }
 
-                m_Stream >> tmp //(
-                    >> ioData.request_time //x
-                    >> tmp //,
-                    >> ioData.duration //y
-                    >> tmp; //)
+        success = success && procCount == m_ProcessCount;
 
-                procIOData[j] = ioData;
+        if (success) {
+            //in theory, number of sigkills <= proc count
+            sigkillCount = _STD min(sigkillCount, m_ProcessCount);
 
-                //if not last element, read a comma
-                if (j < ioCount - 1) {
-                    m_Stream >> tmp;
+            m_ParsedProcesses = new BinaryProcessRecord[procCount];
+            m_ParsedIOData = new ProcessIOData[ioCount];
+            m_ParsedSigkills = new SigkillTimeInfo[sigkillCount];
+
+            //merge in file order, rebasing io pairs
+            int procOffset = 0, ioOffset = 0, sigkillOffset = 0;
+            for (int i = 0; i < chunkCount; i++) {
+                DeserializerChunk* chunk = chunks[i];
+
+                int chunkProcs = chunk->processes.GetLength();
+                for (int j = 0; j < chunkProcs; j++) {
+                    m_ParsedProcesses[procOffset + j] = *chunk->processes[j];
+                    m_ParsedProcesses[procOffset + j].io_first += ioOffset;
+                }
+
+                int chunkIO = chunk->io_data.GetLength();
+                if (chunkIO > 0) {
+                    memcpy(m_ParsedIOData + ioOffset, chunk->io_data[0], sizeof(ProcessIOData) * chunkIO);
+                }
+
+                int chunkSigkills = _STD min(chunk->sigkills.GetLength(), sigkillCount - sigkillOffset);
+                if (chunkSigkills > 0) {
+                    memcpy(m_ParsedSigkills + sigkillOffset, chunk->sigkills[0], sizeof(SigkillTimeInfo) * chunkSigkills);
                 }
+
+                procOffset += chunkProcs;
+                ioOffset += chunkIO;
+                sigkillOffset += chunkSigkills;
             }
 
-            //alloc new proc
-            Process* proc = new Process(pid, at, ct, deadline, procIOData, ioCount);
+            //scheduler expects arrivals sorted by AT, repair the order if needed
+            auto byArrival = [](const BinaryProcessRecord& a, const BinaryProcessRecord& b) {
+                return a.arrival_time < b.arrival_time;
+            };
+
+            if (!_STD is_sorted(m_ParsedProcesses, m_ParsedProcesses + procCount, byArrival)) {
+                _STD stable_sort(m_ParsedProcesses, m_ParsedProcesses + procCount, byArrival);
+            }
 
-            //delete ioData array
-            delete[] procIOData;
+            m_ProcessTable = m_ParsedProcesses;
+            m_IODataTable = m_ParsedIOData;
+            m_SigkillTable = m_ParsedSigkills;
 
-            //add proc to processes array
-            m_Processes[i] = proc;
+            m_IODataTableCount = ioCount;
+            m_SigkillTableCount = sigkillCount;
         }
 
-        data.procs = m_Processes;
+        for (int i = 0; i < chunkCount; i++) {
+            delete chunks[i];
+        }
 
-        //read sig kill times
-        //read till eof
-        //in theory, number of sigkills <= proc count
-        m_Sigkills = new SigkillTimeInfo[data.proc_count];
+        delete[] chunks;
+
+        return success;
+    }
+
+    bool Deserializer::DeserializeBinary(DeserializerData& data) {
+        if (m_File.GetSize() < sizeof(BinaryWorkloadHeader)) {
+            m_Error = L"truncated binary header";
+            return false;
+        }
+
+        const BinaryWorkloadHeader* header = (const BinaryWorkloadHeader*)m_File.GetData();
+        if (header->version != BINARY_WORKLOAD_VERSION) {
+            m_Error = L"unsupported binary workload version " + _STD to_wstring(header->version);
+            return false;
+        }
+
+        if (header->proc_count < 0 || header->io_count < 0 || header->sigkill_count < 0) {
+            m_Error = L"negative table size in binary header";
+            return false;
+        }
+
+        //tables follow the header back to back
+        size_t processesOffset = sizeof(BinaryWorkloadHeader);
+        size_t ioOffset = processesOffset + sizeof(BinaryProcessRecord) * (size_t)header->proc_count;
+        size_t sigkillsOffset = ioOffset + sizeof(ProcessIOData) * (size_t)header->io_count;
+        size_t end = sigkillsOffset + sizeof(SigkillTimeInfo) * (size_t)header->sigkill_count;
+
+        if (m_File.GetSize() < end) {
+            m_Error = L"binary workload is truncated";
+            return false;
+        }
+
+        data.num_processors_fcfs = header->num_processors_fcfs;
+        data.num_processors_sjf = header->num_processors_sjf;
+        data.num_processors_rr = header->num_processors_rr;
+        data.num_processors_edf = header->num_processors_edf;
+        data.rr_timeslice = header->rr_timeslice;
+        data.rtf = header->rtf;
+        data.maxw = header->maxw;
+        data.stl = header->stl;
+        data.fork_prob = header->fork_prob;
+        data.overheat_delay = header->overheat_delay;
+        data.proc_count = header->proc_count;
+
+        m_ProcessTable = (const BinaryProcessRecord*)(m_File.GetData() + processesOffset);
+        m_IODataTable = (const ProcessIOData*)(m_File.GetData() + ioOffset);
+        m_SigkillTable = (const SigkillTimeInfo*)(m_File.GetData() + sigkillsOffset);
+
+        //records are sorted by arrival time, the first update is at timestep 1
+        if (header->proc_count > 0 && m_ProcessTable[0].arrival_time < 1) {
+            m_Error = L"arrival time of the first process is before timestep 1";
+            return false;
+        }
+
+        m_IODataTableCount = header->io_count;
+        m_SigkillTableCount = header->sigkill_count;
+
+        m_ProcessCount = data.proc_count;
+        m_ProcessesRead = 0;
         m_SigkillCount = 0;
 
-        while (!m_Stream.eof()) {
-            if (m_SigkillCount >= data.proc_count) {
-                break;
+        return true;
+    }
+
+    bool Deserializer::ReadProcess(Process** proc, ProcessPool* pool) {
+        if (m_ProcessesRead >= m_ProcessCount) {
+            return false;
+        }
+
+        if (m_ProcessTable != 0) {
+            const BinaryProcessRecord* record = &m_ProcessTable[m_ProcessesRead];
+
+            if (record->io_count < 0 || record->io_first < 0 || record->io_first > m_IODataTableCount - record->io_count) {
+                m_Error = L"io pairs of process record " + _STD to_wstring(m_ProcessesRead) + L" are out of range";
+
+                m_ProcessesRead = m_ProcessCount;
+                return false;
+            }
+
+            m_ProcessesRead++;
+
+            //io pairs are copied straight from the table
+            *proc = pool->Create(record->pid, record->arrival_time, record->cpu_time, record->deadline,
+                (ProcessIOData*)&m_IODataTable[record->io_first], record->io_count);
+
+            return true;
+        }
+
+        //the process section was validated by Deserialize
+        int at, pid, ct, deadline, ioCount;
+        if (!ReadProcessFields(m_ProcessCursor, at, pid, ct, deadline, ioCount)) {
+            m_ProcessesRead = m_ProcessCount;
+            return false;
+        }
+
+        m_ProcessesRead++;
+
+        Process* newProc = pool->Create(pid, at, ct, deadline);
+
+        //io pairs go straight into the process
+        for (int j = 0; j < ioCount; j++) {
+            ProcessIOData ioData;
+            if (!ReadIOPair(m_ProcessCursor, ioData, j == ioCount - 1)) {
+                pool->Destroy(newProc);
+
+                m_ProcessesRead = m_ProcessCount;
+                return false;
+            }
+
+            newProc->AddIOData(ioData);
+        }
+
+        *proc = newProc;
+
+        return true;
+    }
+
+    bool Deserializer::ReadSigkill(SigkillTimeInfo* sigkill) {
+        if (m_SigkillTable != 0 || m_ProcessTable != 0) {
+            if (m_SigkillCount >= m_SigkillTableCount) {
+                return false;
             }
 
-            SigkillTimeInfo info;
+            *sigkill = m_SigkillTable[m_SigkillCount++];
+            return true;
+        }
+
+        //in theory, number of sigkills <= proc count
+        if (m_SigkillCount >= m_ProcessCount) {
+            return false;
+        }
 
-            m_Stream >> info.time
-                >> info.proc_pid;
+        //read till eof
+        if (!SkipWhitespace(m_SigkillCursor)) {
+            return false;
+        }
 
-            m_Sigkills[m_SigkillCount++] = info;
+        SigkillTimeInfo info;
+        if (!ReadInt(m_SigkillCursor, info.time, L"sigkill time") || !ReadInt(m_SigkillCursor, info.proc_pid, L"sigkill pid")) {
+            //dont retry a broken line
+            m_SigkillCount = m_ProcessCount;
+            return false;
         }
 
-        data.sigkills = m_Sigkills;
+        m_SigkillCount++;
+        *sigkill = info;
 
         return true;
     }
-}
+}
\ No newline at end of file
@@ -1,11 +1,15 @@
 #pragma once
 
-#include <fstream>
 #include <string>
 
+#include "../utils/mapped_file.h"
+#include "../collections/array_list.h"
 #include "process.h"
 
 namespace core {
+	struct BinaryProcessRecord;
+	struct DeserializerChunk;
+
 	/// <summary>
 	/// Sigkill time related info
 	/// </summary>
@@ -40,41 +44,124 @@ namespace core {
 
 		//number of processes
 		int proc_count;
+	};
 
-		//processes info
-		Process** procs;
+	/// <summary>
+	/// Scan position in the mapped input file
+	/// </summary>
+	struct TextCursor {
+		// Next character to scan
+		const char* pos;
 
-		//sig kill data
-		SigkillTimeInfo* sigkills;
+		// End of the file
+		const char* end;
+
+		// Current line (1 based), and where it starts, for error reporting
+		int line;
+		const char* line_start;
+
+		// Where the first parse error is recorded
+		_STD wstring* error;
 	};
 
 	/// <summary>
-	/// Deserializes an input file
+	/// Deserializes an input file, processes and sigkills are streamed on demand
+	/// <para>With more than one load thread, the process section of a text file is parsed up front in parallel</para>
 	/// </summary>
 	class Deserializer {
 	private:
 		/// <summary>
-		/// Input file stream
+		/// The input file, mapped in memory
 		/// </summary>
-		_STD ifstream m_Stream;
+		_UTIL MappedFile m_File;
 
 		/// <summary>
-		/// Process array
+		/// Cursor at the next process
 		/// </summary>
-		Process** m_Processes;
-		
+		TextCursor m_ProcessCursor;
+
+		/// <summary>
+		/// Cursor at the next sigkill
+		/// </summary>
+		TextCursor m_SigkillCursor;
+
 		/// <summary>
-		/// Sigkill data
+		/// Number of processes in the file
 		/// </summary>
-		SigkillTimeInfo* m_Sigkills;
+		int m_ProcessCount;
 
 		/// <summary>
-		/// Number of sigkills
+		/// Number of processes read so far
+		/// </summary>
+		int m_ProcessesRead;
+
+		/// <summary>
+		/// Number of sigkills read so far
 		/// </summary>
 		int m_SigkillCount;
 
+		/// <summary>
+		/// Description of the first parse error, empty if none
+		/// </summary>
+		_STD wstring m_Error;
+
+		/// <summary>
+		/// Is the file in the binary workload format?
+		/// </summary>
+		bool m_Binary;
+
+		/// <summary>
+		/// Number of threads parsing a text file, 1 streams it sequentially
+		/// </summary>
+		int m_LoadThreads;
+
+		/// Record tables processes and sigkills are served from, null when streaming text
+		/// they point into the mapping for a binary workload, or into the parsed tables below for a parallel load
+		const BinaryProcessRecord* m_ProcessTable;
+		const ProcessIOData* m_IODataTable;
+		const SigkillTimeInfo* m_SigkillTable;
+
+		int m_IODataTableCount;
+		int m_SigkillTableCount;
+
+		/// Tables owned by a parallel load, processes are sorted by arrival time
+		BinaryProcessRecord* m_ParsedProcesses;
+		ProcessIOData* m_ParsedIOData;
+		SigkillTimeInfo* m_ParsedSigkills;
+
+		/// Reads the header of a binary workload, and locates its tables
+		bool DeserializeBinary(DeserializerData& data);
+
+		/// Parses the process section and the sigkills of a text file on m_LoadThreads threads
+		/// returns false if the file isnt one process or sigkill per line, the caller falls back to streaming
+		bool DeserializeParallel();
+
+		/// Parses the lines of a chunk into its own tables (worker thread)
+		void ParseChunk(DeserializerChunk* chunk);
+
+		/// Skips spaces and tabs, returns true if the cursor is at the end of a line
+		bool SkipToLineEnd(TextCursor& cursor);
+
+		/// Records a parse error at the cursor position
+		void SetError(TextCursor& cursor, const wchar_t* expected);
+
+		/// Skips spaces, tabs and line breaks, returns false at the end of the file
+		bool SkipWhitespace(TextCursor& cursor);
+
+		/// Reads a (possibly negative) decimal integer
+		bool ReadInt(TextCursor& cursor, int& val, const wchar_t* name);
+
+		/// Reads the expected character
+		bool ReadChar(TextCursor& cursor, char c);
+
+		/// Reads the fixed fields of a process line
+		bool ReadProcessFields(TextCursor& cursor, int& at, int& pid, int& ct, int& deadline, int& ioCount);
+
+		/// Reads an io pair in the format of (x,y), followed by a comma if it isnt the last one
+		bool ReadIOPair(TextCursor& cursor, ProcessIOData& ioData, bool last);
+
 	public:
-		Deserializer(_STD wstring& path);
+		Deserializer(_STD wstring& path, int loadThreads = 1);
 		~Deserializer();
 
 		/// <summary>
@@ -83,10 +170,33 @@ namespace core {
 		bool IsValid();
 
 		/// <summary>
-		/// Number of sigkills
+		/// Number of sigkills read so far
 		/// </summary>
 		int GetSigkillCount();
 
+		/// <summary>
+		/// Is the file in the binary workload format?
+		/// </summary>
+		bool IsBinary();
+
+		/// <summary>
+		/// Description of the first parse error with its line and column, empty if none
+		/// </summary>
+		_STD wstring& GetError();
+
+		/// <summary>
+		/// Reads the simulation parameters, and positions the cursors at the first process and sigkill
+		/// </summary>
 		bool Deserialize(DeserializerData& data);
+
+		/// <summary>
+		/// Reads the next process into a slot of pool, false once all processes have been read
+		/// </summary>
+		bool ReadProcess(Process** proc, ProcessPool* pool);
+
+		/// <summary>
+		/// Reads the next sigkill, false once all sigkills have been read
+		/// </summary>
+		bool ReadSigkill(SigkillTimeInfo* sigkill);
 	};
 }
\ No newline at end of file
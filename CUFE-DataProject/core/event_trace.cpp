@@ -0,0 +1,180 @@
+#include "event_trace.h"
+#include "../utils/mapped_file.h"
+#include "../utils/output_file.h"
+
+namespace core {
+	EventTrace::EventTrace() : m_Buffer(0), m_Count(0), m_EventCount(0) {
+	}
+
+	EventTrace::~EventTrace() {
+		Close();
+	}
+
+	bool EventTrace::Open(_STD wstring& filename, _STD wstring& error) {
+		Close();
+
+		if (!_UTIL OpenOutputFile(m_File, filename, _STD ios::out | _STD ios::binary)) {
+			error = L"cannot open trace file";
+			return false;
+		}
+
+		EventTraceHeader header;
+		memset(&header, 0, sizeof(EventTraceHeader));
+		memcpy(header.magic, EVENT_TRACE_MAGIC, 4);
+
+		header.version = EVENT_TRACE_VERSION;
+		header.record_size = sizeof(EventTraceRecord);
+
+		m_File.write((const char*)&header, sizeof(EventTraceHeader));
+
+		m_Buffer = new EventTraceRecord[EVENT_TRACE_BUFFER_SIZE];
+		m_Count = 0;
+		m_EventCount = 0;
+
+		return true;
+	}
+
+	void EventTrace::Close() {
+		if (m_Buffer == 0) return;
+
+		Flush();
+
+		delete[] m_Buffer;
+		m_Buffer = 0;
+
+		m_File.close();
+	}
+
+	void EventTrace::Flush() {
+		if (m_Count == 0) return;
+
+		m_File.write((const char*)m_Buffer, sizeof(EventTraceRecord) * m_Count);
+		m_Count = 0;
+	}
+
+	long long EventTrace::GetEventCount() {
+		return m_EventCount;
+	}
+
+	_STD wstring TraceEventTypeToWString(TraceEventType type) {
+		switch (type) {
+		case TraceEventType::Arrival:
+			return L"ARRIVAL";
+
+		case TraceEventType::Run:
+			return L"RUN";
+
+		case TraceEventType::Block:
+			return L"BLOCK";
+
+		case TraceEventType::IOGrant:
+			return L"IO_GRANT";
+
+		case TraceEventType::IORelease:
+			return L"IO_RELEASE";
+
+		case TraceEventType::Migration:
+			return L"MIGRATION";
+
+		case TraceEventType::Steal:
+			return L"STEAL";
+
+		case TraceEventType::Fork:
+			return L"FORK";
+
+		case TraceEventType::Kill:
+			return L"KILL";
+
+		case TraceEventType::Overheat:
+			return L"OVERHEAT";
+
+		case TraceEventType::Termination:
+			return L"TERMINATION";
+
+		case TraceEventType::Preemption:
+			return L"PREEMPTION";
+
+		default:
+			break;
+		}
+
+		return L"";
+	}
+
+	bool DecodeEventTrace(_STD wstring& src, _STD wstring& dst, bool csv, _STD wstring& error) {
+		_UTIL MappedFile trace;
+		if (!trace.Open(src)) {
+			error = L"cannot open trace file";
+			return false;
+		}
+
+		if (trace.GetSize() < sizeof(EventTraceHeader)) {
+			error = L"trace file is too small";
+			return false;
+		}
+
+		const EventTraceHeader* header = (const EventTraceHeader*)trace.GetData();
+		if (memcmp(header->magic, EVENT_TRACE_MAGIC, 4) != 0) {
+			error = L"not an event trace file";
+			return false;
+		}
+
+		if (header->version != EVENT_TRACE_VERSION || header->record_size != sizeof(EventTraceRecord)) {
+			error = L"unsupported event trace version";
+			return false;
+		}
+
+		//a trace cut short by a crash still decodes up to its last whole record
+		size_t count = (trace.GetSize() - sizeof(EventTraceHeader)) / sizeof(EventTraceRecord);
+		const EventTraceRecord* records = (const EventTraceRecord*)(trace.GetData() + sizeof(EventTraceHeader));
+
+		_STD ofstream file;
+		if (!_UTIL OpenOutputFile(file, dst, _STD ios::out)) {
+			error = L"cannot open output file";
+			return false;
+		}
+
+		//names are plain ascii
+		_STD string names[(int)TraceEventType::MAX];
+		for (int i = 0; i < (int)TraceEventType::MAX; i++) {
+			_STD wstring name = TraceEventTypeToWString((TraceEventType)i);
+			names[i] = _STD string(name.begin(), name.end());
+		}
+
+		if (csv) {
+			file << "timestep,event,pid,processor,arg0,arg1\n";
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			const EventTraceRecord& record = records[i];
+			if (record.type < 0 || record.type >= (int)TraceEventType::MAX) {
+				error = L"unknown event type in trace file";
+				return false;
+			}
+
+			if (csv) {
+				file << record.timestep << ','
+					<< names[record.type] << ','
+					<< record.pid << ','
+					<< record.processor << ','
+					<< record.arg0 << ','
+					<< record.arg1 << '\n';
+			}
+			else {
+				file << '[' << record.timestep << "] "
+					<< names[record.type]
+					<< " pid=" << record.pid
+					<< " processor=" << record.processor
+					<< " arg0=" << record.arg0
+					<< " arg1=" << record.arg1 << '\n';
+			}
+		}
+
+		if (!file.good()) {
+			error = L"failed to write output file";
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+#include <fstream>
+
+// Binary event trace file, little endian
+// header | event records
+#define EVENT_TRACE_MAGIC "SCHT"
+#define EVENT_TRACE_VERSION 1
+
+// Number of events kept in memory before they are written out
+#define EVENT_TRACE_BUFFER_SIZE 4096
+
+namespace core {
+	/// <summary>
+	/// Kind of a traced event, the meaning of the args depends on it
+	/// </summary>
+	enum class TraceEventType {
+		// Process left NEW, arg0=cpu time, arg1=deadline
+		Arrival,
+
+		// Process started running on processor, arg0=remaining time
+		Run,
+
+		// Running process requested IO and moved to BLK, arg0=remaining time
+		Block,
+
+		// Process acquired the IO mutex, arg0=io duration
+		IOGrant,
+
+		// Process released the IO mutex and is scheduled again
+		IORelease,
+
+		// Process migrated, processor is the source, arg0=target processor, arg1=target ProcessorType
+		Migration,
+
+		// Process stolen, processor is the source, arg0=target processor
+		Steal,
+
+		// Process forked, pid is the child, arg0=parent pid
+		Fork,
+
+		// Process killed, arg0=1 if it was a random kill, 0 for sigkills and orphans
+		Kill,
+
+		// Processor overheated, pid is -1, arg0=overheat delay
+		Overheat,
+
+		// Process moved to TRM, arg0=turnaround duration
+		Termination,
+
+		// Running process put back in RDY, arg0=remaining time
+		Preemption,
+
+		MAX
+	};
+
+	/// <summary>
+	/// Fixed size header of an event trace file
+	/// </summary>
+	struct EventTraceHeader {
+		// EVENT_TRACE_MAGIC, not null terminated
+		char magic[4];
+
+		// EVENT_TRACE_VERSION
+		uint32_t version;
+
+		// sizeof(EventTraceRecord)
+		int record_size;
+
+		// Always zero
+		int reserved;
+	};
+
+	/// <summary>
+	/// An event in an event trace file
+	/// </summary>
+	struct EventTraceRecord {
+		int timestep;
+
+		// TraceEventType
+		int type;
+
+		// Process id, -1 if the event isnt about a process
+		int pid;
+
+		// Processor index in the scheduler, -1 if the process has no processor
+		int processor;
+
+		int arg0;
+		int arg1;
+	};
+
+	static_assert(sizeof(EventTraceHeader) == 16, "EventTraceHeader must be packed");
+	static_assert(sizeof(EventTraceRecord) == 24, "EventTraceRecord must be packed");
+
+	/// <summary>
+	/// Appends scheduler events to a binary file, nothing is formatted while the simulation runs
+	/// <para>Events are buffered and written EVENT_TRACE_BUFFER_SIZE at a time, a closed trace drops them</para>
+	/// </summary>
+	class EventTrace {
+	private:
+		/// <summary>
+		/// The trace file
+		/// </summary>
+		_STD ofstream m_File;
+
+		/// <summary>
+		/// Events waiting to be written, null if the trace is closed
+		/// </summary>
+		EventTraceRecord* m_Buffer;
+
+		/// <summary>
+		/// Number of buffered events
+		/// </summary>
+		int m_Count;
+
+		/// <summary>
+		/// Number of events recorded since the trace was opened
+		/// </summary>
+		long long m_EventCount;
+
+		/// Writes the buffered events to the file
+		void Flush();
+
+	public:
+		EventTrace();
+		~EventTrace();
+
+		EventTrace(const EventTrace&) = delete;
+		EventTrace& operator=(const EventTrace&) = delete;
+
+		/// <summary>
+		/// Creates the trace file and writes its header, error is set on failure
+		/// </summary>
+		bool Open(_STD wstring& filename, _STD wstring& error);
+
+		/// <summary>
+		/// Writes the remaining events and closes the file
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// Are events being recorded?
+		/// </summary>
+		bool IsOpen() {
+			return m_Buffer != 0;
+		}
+
+		/// <summary>
+		/// Records an event, ignored if the trace is closed
+		/// </summary>
+		void Write(int timestep, TraceEventType type, int pid, int processor, int arg0 = 0, int arg1 = 0) {
+			if (m_Buffer == 0) return;
+
+			m_Buffer[m_Count++] = { timestep, (int)type, pid, processor, arg0, arg1 };
+			m_EventCount++;
+
+			if (m_Count == EVENT_TRACE_BUFFER_SIZE) {
+				Flush();
+			}
+		}
+
+		/// <summary>
+		/// Number of events recorded since the trace was opened
+		/// </summary>
+		long long GetEventCount();
+	};
+
+	/// <summary>
+	/// Converts TraceEventType to a wide string
+	/// </summary>
+	_STD wstring TraceEventTypeToWString(TraceEventType type);
+
+	/// <summary>
+	/// Decodes an event trace into a text file, one event per line, or into csv, error is set on failure
+	/// </summary>
+	bool DecodeEventTrace(_STD wstring& src, _STD wstring& dst, bool csv, _STD wstring& error);
+}
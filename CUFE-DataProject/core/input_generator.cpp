@@ -10,7 +10,7 @@
 
 namespace core {
 	void GenerateInputFile(InputFileModel* model) {
-		LOG(L"Generating input file...");
+		LOG_INFO(Scheduler, L"Generating input file...");
 
 		//parse model
 		int procCount = _STD stoi(model->proc_count);
@@ -32,6 +32,10 @@ namespace core {
 		int overheat = _STD stoi(model->overheat);
 #endif
 
+		//stream of its own, the scheduler streams stay untouched
+		RandomEngine engine;
+		RandomStream random = engine.CreateStream();
+
 		//output
 		_STD ofstream file(model->filename);
 
@@ -63,16 +67,16 @@ namespace core {
 
 		for (int i = 0; i < procCount; i++) {
 			//increment at by a random val
-			at += RandomEngine::GetInt(0, 2);
+			at += random.GetInt(0, 2);
 
 			int procAt = at;
 			int procPid = pid++;
 
-			int procCpuTime = RandomEngine::GetInt(5, 30);
+			int procCpuTime = random.GetInt(5, 30);
 
-			int procDeadline = procAt + RandomEngine::GetInt(5, procCpuTime);
+			int procDeadline = procAt + random.GetInt(5, procCpuTime);
 
-			int ioCount = RandomEngine::GetInt(0, 10);
+			int ioCount = random.GetInt(0, 10);
 
 			file << procAt << '\t'
 				<< procPid << '\t'
@@ -86,9 +90,9 @@ namespace core {
 
 			int ioBuf = 0;
 			for (int j = 0; j < ioCount; j++) {
-				ioBuf += RandomEngine::GetInt(0, procCpuTime);
+				ioBuf += random.GetInt(0, procCpuTime);
 				int ioR = ioBuf;
-				int ioD = RandomEngine::GetInt(1, 10);
+				int ioD = random.GetInt(1, 10);
 
 				char buf[50];
 				sprintf(buf, "(%d,%d)%s", ioR, ioD, j < ioCount - 1 ? "," : "");
@@ -105,13 +109,13 @@ namespace core {
 			_STD set<int> pids;
 			while (true) {
 				//time increments max is max arrival time / 10
-				time = time + RandomEngine::GetInt(0, at / 10);
+				time = time + random.GetInt(0, at / 10);
 				if (time >= at || pids.size() >= procCount) break;
 
 				//choose pid to be killed
 				int killedPid;
 				do {
-					killedPid = RandomEngine::GetInt(1, pid - 1);
+					killedPid = random.GetInt(1, pid - 1);
 				} while (pids.contains(killedPid));
 
 				pids.insert(killedPid);
@@ -123,6 +127,6 @@ namespace core {
 
 		file.close();
 
-		LOG(L"Done");
+		LOG_INFO(Scheduler, L"Done");
 	}
 }
\ No newline at end of file
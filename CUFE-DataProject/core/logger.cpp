@@ -2,79 +2,149 @@
 #include "scheduler.h"
 
 namespace core {
-	Logger* Logger::ms_Instance = 0;
+	_STD atomic<Logger*> Logger::ms_Instance(0);
+	thread_local Logger* Logger::ms_ThreadInstance = 0;
 
-	Logger::Logger(int maxLogs, Scheduler* scheduler) : m_MaxNumberOfLogs(maxLogs), m_Scheduler(scheduler) {
-		if (ms_Instance == 0) {
-			ms_Instance = this;
-		}
+	Logger::Logger(int maxLogs, Scheduler* scheduler) : m_MaxNumberOfLogs(maxLogs), m_WriteIndex(0), m_Scheduler(scheduler),
+		m_MinLevel((LogLevel)LOG_COMPILE_LEVEL), m_CategoryMask((1u << (int)LogCategory::MAX) - 1) {
+		//first logger is the fallback of every thread
+		Logger* expected = 0;
+		ms_Instance.compare_exchange_strong(expected, this);
+
+		m_PreviousThreadInstance = ms_ThreadInstance;
+		ms_ThreadInstance = this;
 
 		//by default
 		PushColor(COL(BLACK, WHITE));
-		
-		m_Logs = new _COLLECTION LinkedList<LogMessage>();
+
+		//twice the visible logs, so writers rarely lap a reader
+		int slotCount = 1;
+		while (slotCount < maxLogs * 2) {
+			slotCount *= 2;
+		}
+
+		m_Slots = new LogSlot[slotCount];
+		m_SlotMask = slotCount - 1;
+
+		for (int i = 0; i < slotCount; i++) {
+			m_Slots[i].sequence.store(0, _STD memory_order_relaxed);
+		}
 	}
 
 	Logger::~Logger() {
-		delete m_Logs;
+		//loggers are destroyed on the thread that created them
+		if (ms_ThreadInstance == this) {
+			ms_ThreadInstance = m_PreviousThreadInstance;
+		}
+
+		Logger* expected = this;
+		ms_Instance.compare_exchange_strong(expected, 0);
+
+		delete[] m_Slots;
+	}
+
+	void Logger::SetLevel(LogLevel level) {
+		m_MinLevel = level;
 	}
 
-	_COLLECTION LinkedList<LogMessage>* Logger::GetLogs() {
-		return m_Logs;
+	LogLevel Logger::GetLevel() {
+		return m_MinLevel;
 	}
 
-	Logger* Logger::GetInstance() {
-		return ms_Instance;
+	void Logger::SetCategoryEnabled(LogCategory category, bool enabled) {
+		if (enabled) {
+			m_CategoryMask |= 1u << (int)category;
+		}
+		else {
+			m_CategoryMask &= ~(1u << (int)category);
+		}
 	}
 
-	void Logger::Log(LogMessage msg, bool acquireMutex) {
-		if (acquireMutex) { //prevent deadlock
-			m_LoggerLock.Acquire();
+	int Logger::GetLogs(LogMessage* logs, int maxLogs) {
+		if (maxLogs > m_MaxNumberOfLogs) {
+			maxLogs = m_MaxNumberOfLogs;
 		}
 
-		constexpr int maxLen = LOG_WIDTH - 7;
+		unsigned long long end = m_WriteIndex.load(_STD memory_order_acquire);
+		unsigned long long begin = end > (unsigned long long)maxLogs ? end - maxLogs : 0;
 
-		int ts = m_Scheduler->GetSimulationInfo()->GetTimestep();
+		int count = 0;
+		for (unsigned long long ticket = begin; ticket < end; ticket++) {
+			LogSlot* slot = &m_Slots[ticket & m_SlotMask];
+
+			//skip slots still being written, or already reused
+			unsigned long long sequence = slot->sequence.load(_STD memory_order_acquire);
+			if (sequence != ticket * 2 + 2) continue;
 
-		//remove first log
-		if (m_Logs->GetLength() == m_MaxNumberOfLogs) {
-			m_Logs->Remove(*(*m_Logs)[0]);
+			logs[count] = slot->message;
+
+			//rewritten while copying?
+			_STD atomic_thread_fence(_STD memory_order_acquire);
+			if (slot->sequence.load(_STD memory_order_relaxed) != sequence) continue;
+
+			count++;
 		}
 
-		while (msg.text.length() > maxLen) {
-			Log(LogMessage{ 
-				msg.text.substr(0, maxLen),
-				msg.color
-			}, false);
+		return count;
+	}
+
+	void Logger::Write(int timestep, const wchar_t* text, int length, _UI Color color) {
+		unsigned long long ticket = m_WriteIndex.fetch_add(1, _STD memory_order_relaxed);
+		LogSlot* slot = &m_Slots[ticket & m_SlotMask];
+
+		//mark as being written
+		slot->sequence.store(ticket * 2 + 1, _STD memory_order_relaxed);
+		_STD atomic_thread_fence(_STD memory_order_release);
+
+		//truncated to the slot, never past it
+		_snwprintf_s(slot->message.text, LOG_WIDTH, _TRUNCATE, L"[%d] %.*s", timestep, length, text);
+		slot->message.color = color;
+
+		//publish
+		slot->sequence.store(ticket * 2 + 2, _STD memory_order_release);
+	}
 
-			msg.text = msg.text.substr(maxLen);
+	void Logger::Log(const wchar_t* msg, _UI Color color) {
+		int ts = m_Scheduler->GetSimulationInfo()->GetTimestep();
+
+		//every line starts with "[ts] ", the rest of the slot minus the terminator is left for the message
+		int prefixLength = 4;
+		for (int digits = ts; digits >= 10; digits /= 10) {
+			prefixLength++;
 		}
 
-		if (msg.text.size() > 0) {
-			wchar_t buf[LOG_WIDTH];
-			swprintf(buf, L"[%d] %s", ts, msg.text.c_str());
-			msg.text = buf;
+		int maxLen = LOG_WIDTH - 1 - prefixLength;
 
-			m_Logs->Add(msg);
+		//split long messages
+		int length = (int)wcslen(msg);
+		while (length > maxLen) {
+			Write(ts, msg, maxLen, color);
+
+			msg += maxLen;
+			length -= maxLen;
 		}
 
-		if (acquireMutex) {
-			m_LoggerLock.Release();
+		if (length > 0) {
+			Write(ts, msg, length, color);
 		}
 	}
 
-	void Logger::Log(_STD wstring msg) {
+	void Logger::Log(const wchar_t* msg) {
 		//we already know that we have atleast one color
 		_UI Color col;
 		m_ColorStack.Peek(col);
 
-		Log(LogMessage{ msg, col });
+		Log(msg, col);
+	}
+
+	void Logger::Log(const _STD wstring& msg) {
+		Log(msg.c_str());
 	}
 
 	void Logger::PushColor(_UI Color color) {
-		m_LoggerLock.Acquire();
+		m_ColorLock.Acquire();
 		m_ColorStack.Push(color);
-		m_LoggerLock.Release();
+		m_ColorLock.Release();
 	}
 
 	void Logger::PopColor() {
@@ -83,8 +153,4 @@ namespace core {
 			m_ColorStack.Pop();
 		}
 	}
-
-	_UTIL Lock* Logger::GetLoggerLock() {
-		return &m_LoggerLock;
-	}
-}
\ No newline at end of file
+}
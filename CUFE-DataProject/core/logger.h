@@ -2,14 +2,58 @@
 
 #include "../common.h"
 #include "../ui/color.h"
-#include "../collections/linked_list.h"
 #include "../collections/linked_stack.h"
 #include "../utils/lock.h"
 
 #include <string>
-
-#define LOG(msg) core::Logger::GetInstance()->Log(msg)
-#define LOGF(fmt, ...) { wchar_t __tmpBuf[100]; swprintf(__tmpBuf, fmt, __VA_ARGS__); LOG(__tmpBuf); }
+#include <atomic>
+
+// Logs at a level and category, msg is only evaluated if the runtime filter lets the line through
+#define LOG_AT(level, cat, msg) { core::Logger* __logger = core::Logger::GetInstance(); \
+	if (__logger->IsEnabled(core::LogLevel::level, core::LogCategory::cat)) __logger->Log(msg); }
+
+// Formats only if the runtime filter lets the line through, the formatted line is truncated to the buffer
+#define LOGF_AT(level, cat, fmt, ...) { core::Logger* __logger = core::Logger::GetInstance(); \
+	if (__logger->IsEnabled(core::LogLevel::level, core::LogCategory::cat)) { \
+		wchar_t __tmpBuf[100]; _snwprintf_s(__tmpBuf, _countof(__tmpBuf), _TRUNCATE, fmt, __VA_ARGS__); __logger->Log(__tmpBuf); } }
+
+// Per level macros, levels below LOG_COMPILE_LEVEL expand to nothing
+// e.g. LOGF_DEBUG(IO, L"Acquiring mutex, pid=%d", pid);
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(cat, msg) LOG_AT(Trace, cat, msg)
+#define LOGF_TRACE(cat, fmt, ...) LOGF_AT(Trace, cat, fmt, __VA_ARGS__)
+#else
+#define LOG_TRACE(cat, msg)
+#define LOGF_TRACE(cat, fmt, ...)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(cat, msg) LOG_AT(Debug, cat, msg)
+#define LOGF_DEBUG(cat, fmt, ...) LOGF_AT(Debug, cat, fmt, __VA_ARGS__)
+#else
+#define LOG_DEBUG(cat, msg)
+#define LOGF_DEBUG(cat, fmt, ...)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(cat, msg) LOG_AT(Info, cat, msg)
+#define LOGF_INFO(cat, fmt, ...) LOGF_AT(Info, cat, fmt, __VA_ARGS__)
+#else
+#define LOG_INFO(cat, msg)
+#define LOGF_INFO(cat, fmt, ...)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(cat, msg) LOG_AT(Warning, cat, msg)
+#define LOGF_WARNING(cat, fmt, ...) LOGF_AT(Warning, cat, fmt, __VA_ARGS__)
+#else
+#define LOG_WARNING(cat, msg)
+#define LOGF_WARNING(cat, fmt, ...)
+#endif
+
+//errors are never compiled out
+#define LOG_ERROR(cat, msg) LOG_AT(Error, cat, msg)
+#define LOGF_ERROR(cat, fmt, ...) LOGF_AT(Error, cat, fmt, __VA_ARGS__)
 
 #define PUSHCOL(col) core::Logger::GetInstance()->PushColor(col)
 #define POPCOL() core::Logger::GetInstance()->PopColor()
@@ -17,74 +61,171 @@
 namespace core {
 	class Scheduler;
 
+	/// <summary>
+	/// Severity of a log line
+	/// </summary>
+	enum class LogLevel {
+		Trace = LOG_LEVEL_TRACE,
+		Debug = LOG_LEVEL_DEBUG,
+		Info = LOG_LEVEL_INFO,
+		Warning = LOG_LEVEL_WARNING,
+		Error = LOG_LEVEL_ERROR,
+		MAX
+	};
+
+	/// <summary>
+	/// Subsystem a log line comes from
+	/// </summary>
+	enum class LogCategory {
+		Scheduler,
+		Processor,
+		IO,
+		Steal,
+		Fork,
+		Kill,
+		MAX
+	};
+
+	/// <summary>
+	/// A log line, fixed size so logging never allocates
+	/// </summary>
 	struct LogMessage {
-		_STD wstring text;
+		wchar_t text[LOG_WIDTH];
 		_UI Color color;
-
-		bool operator==(LogMessage& other) {
-			return text == other.text && color == other.color;
-		}
 	};
 
+	/// <summary>
+	/// Keeps the last log lines in a preallocated ring of slots
+	/// <para>Writers claim slots with an atomic index and never block, readers copy a snapshot and skip slots that are
+	/// being rewritten</para>
+	/// </summary>
 	class Logger {
 	private:
+		/// A ring slot, sequence is 2 * ticket + 1 while the message is written and 2 * ticket + 2 once it is done
+		struct LogSlot {
+			_STD atomic<unsigned long long> sequence;
+			LogMessage message;
+		};
+
+		/// <summary>
+		/// Ring of log slots, a power of two
+		/// </summary>
+		LogSlot* m_Slots;
+
 		/// <summary>
-		/// List of log entries
+		/// Number of slots - 1
 		/// </summary>
-		_COLLECTION LinkedList<LogMessage>* m_Logs;
+		int m_SlotMask;
 
 		/// <summary>
 		/// Max number of logs
 		/// </summary>
 		int m_MaxNumberOfLogs;
 
+		/// <summary>
+		/// Ticket of the next log line, slot is ticket & m_SlotMask
+		/// </summary>
+		_STD atomic<unsigned long long> m_WriteIndex;
+
 		/// <summary>
 		/// The scheduler
 		/// </summary>
 		Scheduler* m_Scheduler;
 
+		/// <summary>
+		/// Lines below this level are dropped before formatting
+		/// </summary>
+		LogLevel m_MinLevel;
+
+		/// <summary>
+		/// Bit per LogCategory, lines of cleared categories are dropped before formatting
+		/// </summary>
+		unsigned int m_CategoryMask;
+
 		// Color stack
 		_COLLECTION LinkedStack<_UI Color> m_ColorStack;
 
-		/// Log lock
-		_UTIL Lock m_LoggerLock;
+		/// Color stack lock
+		_UTIL Lock m_ColorLock;
+
+		/// <summary>
+		/// Logger of the first scheduler, used by threads that have none bound (the UI thread)
+		/// </summary>
+		static _STD atomic<Logger*> ms_Instance;
 
 		/// <summary>
-		/// Singleton instance
+		/// Logger bound to the calling thread, schedulers running side by side each log into their own
 		/// </summary>
-		static Logger* ms_Instance;
+		static thread_local Logger* ms_ThreadInstance;
+
+		/// <summary>
+		/// Logger that was bound to the creating thread before this one
+		/// </summary>
+		Logger* m_PreviousThreadInstance;
+
+		/// Writes a line into the next slot, text is cut at the slot width
+		void Write(int timestep, const wchar_t* text, int length, _UI Color color);
 
 	public:
+		/// <summary>
+		/// Creates a logger and binds it to the calling thread until it is destroyed
+		/// </summary>
 		Logger(int maxLogs, Scheduler* scheduler);
 		~Logger();
 
 		/// <summary>
-		/// Returns the singleton instance
+		/// Returns the logger bound to the calling thread, or the logger of the first scheduler
+		/// </summary>
+		static Logger* GetInstance() {
+			return ms_ThreadInstance != 0 ? ms_ThreadInstance : ms_Instance.load(_STD memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Would a line at this level and category be kept?
 		/// </summary>
-		static Logger* GetInstance();
+		bool IsEnabled(LogLevel level, LogCategory category) {
+			return level >= m_MinLevel && (m_CategoryMask & (1u << (int)category)) != 0;
+		}
 
 		/// <summary>
-		/// Returns the logs
+		/// Sets the lowest level that is kept, LogLevel::MAX drops every line
 		/// </summary>
-		_COLLECTION LinkedList<LogMessage>* GetLogs();
+		void SetLevel(LogLevel level);
 
 		/// <summary>
-		/// Adds a log entry
+		/// Lowest level that is kept
 		/// </summary>
-		void Log(LogMessage msg, bool acquireMutex = true);
+		LogLevel GetLevel();
 
 		/// <summary>
-		/// Adds a log entry
+		/// Enables or disables the lines of a category
 		/// </summary>
-		void Log(_STD wstring msg);
+		void SetCategoryEnabled(LogCategory category, bool enabled);
+
+		/// <summary>
+		/// Copies the most recent logs (at most maxLogs), oldest first, returns the number copied
+		/// </summary>
+		int GetLogs(LogMessage* logs, int maxLogs);
+
+		/// <summary>
+		/// Adds a log entry, long messages are split into several lines
+		/// </summary>
+		void Log(const wchar_t* msg, _UI Color color);
+
+		/// <summary>
+		/// Adds a log entry with the current color
+		/// </summary>
+		void Log(const wchar_t* msg);
+
+		/// <summary>
+		/// Adds a log entry with the current color
+		/// </summary>
+		void Log(const _STD wstring& msg);
 
 		// Pushes a new color to the stack
 		void PushColor(_UI Color color);
 
 		// Pops a color from the stack
 		void PopColor();
-
-		/// Returns the logger lock
-		_UTIL Lock* GetLoggerLock();
 	};
-}
\ No newline at end of file
+}
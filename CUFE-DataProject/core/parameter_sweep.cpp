@@ -0,0 +1,243 @@
+#include "parameter_sweep.h"
+#include "scheduler.h"
+#include "../utils/worker_pool.h"
+#include "../utils/output_file.h"
+
+#include <fstream>
+#include <climits>
+
+namespace core {
+	/// Number of entries of a swept list, an empty list is a single entry keeping the base value
+	static int GetEntryCount(_COLLECTION ArrayList<int>& values, int fieldCount) {
+		int count = values.GetLength() / fieldCount;
+		return count > 0 ? count : 1;
+	}
+
+	ParameterSweep::ParameterSweep(_STD wstring& filename, SweepGrid* grid) : m_Filename(filename), m_Grid(grid), m_Seed(0), m_Seeded(false) {
+		m_RunCount = GetEntryCount(grid->processor_counts, 4);
+		for (int i = 0; i < (int)SweepParameter::MAX; i++) {
+			m_RunCount *= GetEntryCount(grid->values[i], 1);
+		}
+
+		m_Results = new SweepResult[m_RunCount];
+	}
+
+	ParameterSweep::~ParameterSweep() {
+		delete[] m_Results;
+	}
+
+	int ParameterSweep::GetRunCount() {
+		return m_RunCount;
+	}
+
+	void ParameterSweep::SetSeed(uint64_t seed) {
+		m_Seed = seed;
+		m_Seeded = true;
+	}
+
+	SweepResult* ParameterSweep::GetResult(int run) {
+		return &m_Results[run];
+	}
+
+	void ParameterSweep::GetRunOverrides(int run, DeserializerData& overrides) {
+		memset(&overrides, -1, sizeof(DeserializerData));
+
+		int* fields[(int)SweepParameter::MAX] = {
+			&overrides.rr_timeslice, &overrides.rtf, &overrides.maxw, &overrides.stl, &overrides.fork_prob
+		};
+
+		//last parameter varies fastest, processor counts slowest
+		for (int i = (int)SweepParameter::MAX - 1; i >= 0; i--) {
+			_COLLECTION ArrayList<int>& values = m_Grid->values[i];
+			int count = GetEntryCount(values, 1);
+
+			if (values.GetLength() > 0) {
+				*fields[i] = *values[run % count];
+			}
+
+			run /= count;
+		}
+
+		_COLLECTION ArrayList<int>& counts = m_Grid->processor_counts;
+		if (counts.GetLength() > 0) {
+			overrides.num_processors_fcfs = *counts[run * 4];
+			overrides.num_processors_sjf = *counts[run * 4 + 1];
+			overrides.num_processors_rr = *counts[run * 4 + 2];
+			overrides.num_processors_edf = *counts[run * 4 + 3];
+		}
+	}
+
+	void ParameterSweep::ExecuteRun(int run) {
+		SweepResult* result = &m_Results[run];
+		long long start = UpdateProfiler::Now();
+
+		DeserializerData overrides;
+		GetRunOverrides(run, overrides);
+
+		//too big for a worker stack, its logger is bound to this thread while it lives
+		Scheduler* sched = new Scheduler();
+		sched->GetLogger()->SetLevel(LogLevel::MAX);
+
+		//results are collected in memory, runs would overwrite each others output.txt
+		sched->SetOutputFile("");
+
+		if (m_Seeded) {
+			sched->GetRandomEngine()->SetSeed(m_Seed);
+		}
+
+		result->seed = sched->GetRandomEngine()->GetSeed();
+
+		sched->LoadSerializedData(m_Filename, &overrides);
+
+		LoadFileInfo* fileInfo = sched->GetLoadFileInfo();
+		result->parameters = fileInfo->data;
+		result->success = fileInfo->success;
+		result->error = fileInfo->error;
+
+		if (result->success) {
+			SimulationInfo* simInfo = sched->GetSimulationInfo();
+			simInfo->SetMode(SimulationMode::Silent);
+			simInfo->SetEventDriven(true);
+			simInfo->Start();
+
+			int sleepTime;
+			while (simInfo->CanUpdateScheduler(&sleepTime)) {
+				sched->Update();
+			}
+		}
+
+		Statistics* stats = sched->GetStatistics();
+		result->process_count = stats->GetProcessCount();
+		result->last_time = stats->GetLastTime();
+		result->avg_waiting_time = stats->GetAverageWaitingTime();
+		result->avg_response_time = stats->GetAverageResponseTime();
+		result->avg_turnaround_duration = stats->GetAverageTurnaroundDuration();
+		result->p99_turnaround_duration = stats->GetLatencyHistogram(LatencyMetric::TurnaroundDuration)->GetPercentile(99.0);
+		result->migration_rtf = stats->GetStatistic(StatisticType::MigrationRTF);
+		result->migration_maxw = stats->GetStatistic(StatisticType::MigrationMaxW);
+		result->work_steal = stats->GetStatistic(StatisticType::WorkSteal);
+		result->fork = stats->GetStatistic(StatisticType::Fork);
+		result->kill = stats->GetStatistic(StatisticType::Kill);
+		result->avg_utilization = sched->GetAverageProcessorUtilization();
+
+		delete sched;
+
+		result->wall_time = UpdateProfiler::Now() - start;
+	}
+
+	bool ParameterSweep::Run(int threads, _STD wstring& error) {
+		//a run without processors never terminates
+		_COLLECTION ArrayList<int>& counts = m_Grid->processor_counts;
+		for (int i = 0; i + 3 < counts.GetLength(); i += 4) {
+			if (*counts[i] + *counts[i + 1] + *counts[i + 2] + *counts[i + 3] == 0) {
+				error = L"every processor count entry needs atleast one processor";
+				return false;
+			}
+		}
+
+		_UTIL WorkerPool pool;
+		pool.Start(threads);
+
+		//runs differ wildly in length, idle workers steal the ones not started yet
+		pool.ParallelForEach(m_RunCount, [this](int run) {
+			ExecuteRun(run);
+		});
+
+		pool.Stop();
+
+		for (int i = 0; i < m_RunCount; i++) {
+			if (!m_Results[i].success) {
+				error = L"run " + _STD to_wstring(i + 1) + L" failed, " + m_Results[i].error;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ParameterSweep::WriteResults(_STD wstring& filename, _STD wstring& error) {
+		_STD ofstream file;
+		if (!_UTIL OpenOutputFile(file, filename, _STD ios::out)) {
+			error = L"cannot open results file";
+			return false;
+		}
+
+		file << "RUN\tSEED\tFCFS\tSJF\tRR\tEDF\tRR_SLICE\tRTF\tMAXW\tSTL\tFORK_PROB\t"
+			"PROCESSES\tLAST_TIME\tAVG_WT\tAVG_RT\tAVG_TRT\tP99_TRT\tMIGRATION_RTF\tMIGRATION_MAXW\tWORK_STEAL\tFORK\tKILL\t"
+			"AVG_UTIL\tWALL_MS\n";
+
+		char buf[512];
+		for (int i = 0; i < m_RunCount; i++) {
+			SweepResult* result = &m_Results[i];
+			DeserializerData* data = &result->parameters;
+
+			sprintf(buf, "%d\t%llu\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%.4f\t%.3f\n",
+				i + 1,
+				(unsigned long long)result->seed,
+				data->num_processors_fcfs,
+				data->num_processors_sjf,
+				data->num_processors_rr,
+				data->num_processors_edf,
+				data->rr_timeslice,
+				data->rtf,
+				data->maxw,
+				data->stl,
+				data->fork_prob,
+				result->process_count,
+				result->last_time,
+				result->avg_waiting_time,
+				result->avg_response_time,
+				result->avg_turnaround_duration,
+				result->p99_turnaround_duration,
+				result->migration_rtf,
+				result->migration_maxw,
+				result->work_steal,
+				result->fork,
+				result->kill,
+				result->avg_utilization,
+				result->wall_time / 1000000.0);
+
+			file << buf;
+		}
+
+		return file.good();
+	}
+
+	bool ParseSweepValues(const _STD string& text, int fieldCount, int minValue, _COLLECTION ArrayList<int>& values, _STD wstring& error) {
+		const char* pos = text.c_str();
+
+		while (true) {
+			for (int field = 0; field < fieldCount; field++) {
+				char* end;
+				long value = strtol(pos, &end, 10);
+
+				if (end == pos || value < minValue || value > INT_MAX) {
+					error = L"invalid value in \"" + _STD wstring(text.begin(), text.end()) + L"\"";
+					return false;
+				}
+
+				values.Add((int)value);
+				pos = end;
+
+				//fields of an entry are colon separated
+				if (field < fieldCount - 1) {
+					if (*pos != ':') {
+						error = L"expected " + _STD to_wstring(fieldCount) + L" fields per entry in \"" + _STD wstring(text.begin(), text.end()) + L"\"";
+						return false;
+					}
+
+					pos++;
+				}
+			}
+
+			if (*pos == 0) return true;
+
+			if (*pos != ',') {
+				error = L"unexpected character in \"" + _STD wstring(text.begin(), text.end()) + L"\"";
+				return false;
+			}
+
+			pos++;
+		}
+	}
+}
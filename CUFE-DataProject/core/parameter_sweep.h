@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../common.h"
+#include "../collections/array_list.h"
+#include "deserializer.h"
+
+#include <string>
+#include <cstdint>
+
+namespace core {
+	/// <summary>
+	/// Simulation parameters a sweep iterates over
+	/// </summary>
+	enum class SweepParameter {
+		RRTimeslice,
+		RTF,
+		MaxW,
+		STL,
+		ForkProb,
+
+		MAX
+	};
+
+	/// <summary>
+	/// Values of every swept parameter, an empty list keeps the value of the base workload
+	/// <para>Every combination of the values is a run</para>
+	/// </summary>
+	struct SweepGrid {
+		// Values per parameter
+		_COLLECTION ArrayList<int> values[(int)SweepParameter::MAX];
+
+		// FCFS, SJF, RR and EDF counts, 4 values per entry
+		_COLLECTION ArrayList<int> processor_counts;
+	};
+
+	/// <summary>
+	/// Outcome of a single run of a sweep
+	/// </summary>
+	struct SweepResult {
+		// Parameters the run was simulated with
+		DeserializerData parameters;
+
+		// Seed of the random streams, the run is reproducible from it
+		uint64_t seed;
+
+		// Loaded and ran to completion?
+		bool success;
+
+		// Load error, empty if successful
+		_STD wstring error;
+
+		// Number of terminated processes
+		int process_count;
+
+		// Timestep at which the last process terminated
+		int last_time;
+
+		// Averages over all processes
+		int avg_waiting_time;
+		int avg_response_time;
+		int avg_turnaround_duration;
+
+		// 99th percentile of the turnaround duration
+		int p99_turnaround_duration;
+
+		// Number of recorded statistics per StatisticType
+		int migration_rtf;
+		int migration_maxw;
+		int work_steal;
+		int fork;
+		int kill;
+
+		// Average processor utilization, between 0 and 1
+		float avg_utilization;
+
+		// Wall clock time of the run in nanoseconds
+		long long wall_time;
+	};
+
+	/// <summary>
+	/// Runs every configuration of a grid over a base workload, each as an independent Scheduler
+	/// <para>Runs are spread over a work stealing pool and collected into one results table</para>
+	/// </summary>
+	class ParameterSweep {
+	private:
+		/// <summary>
+		/// Base workload
+		/// </summary>
+		_STD wstring m_Filename;
+
+		/// <summary>
+		/// The swept values
+		/// </summary>
+		SweepGrid* m_Grid;
+
+		/// <summary>
+		/// Result per run, in configuration order
+		/// </summary>
+		SweepResult* m_Results;
+
+		/// <summary>
+		/// Number of configurations in the grid
+		/// </summary>
+		int m_RunCount;
+
+		/// <summary>
+		/// Seed of every run, only used if m_Seeded
+		/// </summary>
+		uint64_t m_Seed;
+
+		/// <summary>
+		/// Are runs seeded with m_Seed? otherwise each run is seeded from the random device
+		/// </summary>
+		bool m_Seeded;
+
+		/// Parameter overrides of a run, -1 keeps the value of the base workload
+		void GetRunOverrides(int run, DeserializerData& overrides);
+
+		/// Simulates a run to completion and records its result
+		void ExecuteRun(int run);
+
+	public:
+		ParameterSweep(_STD wstring& filename, SweepGrid* grid);
+		~ParameterSweep();
+
+		ParameterSweep(const ParameterSweep&) = delete;
+		ParameterSweep& operator=(const ParameterSweep&) = delete;
+
+		/// <summary>
+		/// Number of configurations in the grid
+		/// </summary>
+		int GetRunCount();
+
+		/// <summary>
+		/// Seeds every run with the same seed
+		/// </summary>
+		void SetSeed(uint64_t seed);
+
+		/// <summary>
+		/// Result of a run, valid after Run
+		/// </summary>
+		SweepResult* GetResult(int run);
+
+		/// <summary>
+		/// Simulates every configuration on threads threads, false if any of them failed to load
+		/// </summary>
+		bool Run(int threads, _STD wstring& error);
+
+		/// <summary>
+		/// Writes the results as a tab separated table, one line per run
+		/// </summary>
+		bool WriteResults(_STD wstring& filename, _STD wstring& error);
+	};
+
+	/// <summary>
+	/// Parses a comma separated list of entries of fieldCount colon separated integers, each at least minValue
+	/// <para>e.g. "5,10,20" or "2:2:2:2,4:4:4:4"</para>
+	/// </summary>
+	bool ParseSweepValues(const _STD string& text, int fieldCount, int minValue, _COLLECTION ArrayList<int>& values, _STD wstring& error);
+}
@@ -1,6 +1,8 @@
 #include "process.h"
 #include "processor.h"
 
+#include <climits>
+
 namespace core {
 	Process::Process(int pid, int at, int ct, int deadline, ProcessIOData* ioData, int ioDataSz) : m_PID(pid), m_ArrivalTime(at), m_CpuTime(ct), m_Deadline(deadline),
 		m_ResponseTime(-1), m_TerminationTime(0), m_TotalIOTime(0), m_Ticks(0), m_Owner(0), m_State(ProcessState::NEW) {
@@ -17,11 +19,15 @@ namespace core {
 		//initialize forking data
 		memset(&m_ForkingData, 0, sizeof(ForkingData));
 
-		//create root
-		m_ForkingData.fork_tree.Insert(0, this);
+		//our node is the root
+		m_ForkingData.fork_node.value = this;
+		m_ForkingData.fork_tree.InsertForeign(0, &m_ForkingData.fork_node);
 
 		//init dynamic metadata
 		memset(&m_DynamicMetadata, 0, sizeof(ProcessDynamicMetadata));
+
+		//not queued yet
+		memset(&m_QueueHook, 0, sizeof(_COLLECTION IntrusiveListHook<Process>));
 	}
 
 	int Process::GetPID() {
@@ -84,8 +90,8 @@ namespace core {
 		m_State = state;
 	}
 
-	void Process::Tick(int timestep) {
-		m_Ticks++;
+	void Process::Tick(int timestep, int count) {
+		m_Ticks += count;
 
 		//check for response time
 		if (m_ResponseTime == -1) {
@@ -106,6 +112,14 @@ namespace core {
 		return !m_IODataQueue.IsEmpty();
 	}
 
+	int Process::GetTicksToIOEvent() {
+		ProcessIOData ioData;
+		if (!m_IODataQueue.Peek(&ioData)) return INT_MAX;
+
+		//checked after ticking, so atleast 1
+		return ioData.request_time > m_Ticks ? ioData.request_time - m_Ticks : 1;
+	}
+
 	ProcessIOData Process::GetIOData() {
 		ProcessIOData data;
 		m_IODataQueue.Dequeue(&data);
@@ -113,6 +127,11 @@ namespace core {
 		return data;
 	}
 
+	void Process::AddIOData(ProcessIOData ioData) {
+		m_IODataQueue.Enqueue(ioData);
+		m_TotalIOTime += ioData.duration;
+	}
+
 	int Process::GetRemainingTime() {
 		return m_CpuTime - m_Ticks;
 	}
@@ -135,6 +154,10 @@ namespace core {
 		return &m_DynamicMetadata;
 	}
 
+	_COLLECTION IntrusiveListHook<Process>* Process::GetQueueHook() {
+		return &m_QueueHook;
+	}
+
 	_STD wstringstream& operator<<(_STD wstringstream& stream, Process* proc) {
 		stream << proc->m_PID;
 		return stream;
@@ -154,37 +177,22 @@ namespace core {
 }
 
 namespace collections {
-	void ProcessLinkedList::Print(_STD wstringstream& stream) {
-		if (m_Head == 0) return;
-
-		for (LinkedListNode<_CORE Process*>* node = m_Head; node; node = node->next) {
-			stream << node->value << L", ";
+	void ProcessIntrusiveList::Print(_STD wstringstream& stream) {
+		for (_CORE Process* proc = m_Head; proc; proc = proc->GetQueueHook()->next) {
+			stream << proc << L", ";
 		}
 	}
 
-	_CORE Process* ProcessLinkedList::GetProcessWithID(int pid) {
-		if (m_Head == 0) return 0;
+	void ProcessArrayDeque::Print(_STD wstringstream& stream) {
+		_CORE Process** segments[2];
+		int counts[2];
 
-		//quick check
-		if (m_Head->value->GetPID() == pid) return m_Head->value;
-		if (m_Head->value->GetPID() == pid) return m_Tail->value;
-
-		//not head, not tail, start traversal
-		LinkedListNode<_CORE Process*>* node = m_Head;
-		while (node = node->next) {
-			if (node->value->GetPID() == pid) {
-				return node->value;
+		//walk the contiguous segments in order
+		int segmentCount = GetSegments(&segments[0], &counts[0], &segments[1], &counts[1]);
+		for (int s = 0; s < segmentCount; s++) {
+			for (int i = 0; i < counts[s]; i++) {
+				stream << segments[s][i] << L", ";
 			}
 		}
-
-		return 0;
-	}
-
-	void ProcessLinkedQueue::Print(_STD wstringstream& stream) {
-		if (m_LinkedList.GetHead() == 0) return;
-
-		for (LinkedListNode<_CORE Process*>* node = m_LinkedList.GetHead(); node; node = node->next) {
-			stream << node->value << L", ";
-		}
 	}
 }
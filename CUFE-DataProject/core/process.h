@@ -4,11 +4,16 @@
 #include "../collections/linked_list.h"
 #include "../collections/linked_queue.h"
 #include "../collections/linked_priority_queue.h"
+#include "../collections/array_priority_queue.h"
 #include "../collections/binary_tree.h"
+#include "../collections/object_pool.h"
+#include "../collections/intrusive_list.h"
+#include "../collections/array_deque.h"
 #include "states.h"
 
 #include <sstream>
 #include <functional>
+#include <algorithm>
 
 #define PROC_BT_NODE _COLLECTION BinaryTreeNode<Process*>
 
@@ -39,6 +44,9 @@ namespace core {
 		// Fork tree
 		_COLLECTION BinaryTree<Process*> fork_tree;
 
+		// Our own node, root of fork_tree, stored inline so forking doesnt allocate
+		PROC_BT_NODE fork_node;
+
 		// Our foreign node address
 		PROC_BT_NODE** forgein_node;
 
@@ -52,6 +60,9 @@ namespace core {
 
 		// Has the process been stolen before?
 		bool stolen;
+
+		// Was the process killed (sigkill, random kill or orphan)?
+		bool killed;
 	};
 
 	class Process {
@@ -82,8 +93,8 @@ namespace core {
 		// Current process state
 		ProcessState m_State;
 
-		// IO data qeueue
-		_COLLECTION LinkedQueue<ProcessIOData> m_IODataQueue;
+		// IO data qeueue, a handful of nodes per process so they come from the heap rather than a pool per process
+		_COLLECTION LinkedQueue<ProcessIOData, _COLLECTION HeapAllocator<_COLLECTION LinkedListNode<ProcessIOData>>> m_IODataQueue;
 
 		// Forking related info
 		ForkingData m_ForkingData;
@@ -91,6 +102,9 @@ namespace core {
 		// Some dynamic metadata
 		ProcessDynamicMetadata m_DynamicMetadata;
 
+		// Links of the intrusive RDY queue holding the process
+		_COLLECTION IntrusiveListHook<Process> m_QueueHook;
+
 		friend _STD wstringstream& operator<<(_STD wstringstream& stream, Process* proc);
 
 	public:
@@ -158,9 +172,9 @@ namespace core {
 		void SetState(ProcessState state);
 
 		/// <summary>
-		/// Increments the ticks
+		/// Increments the ticks, timestep is the one of the first tick
 		/// </summary>
-		void Tick(int timestep);
+		void Tick(int timestep, int count = 1);
 
 		/// <summary>
 		/// Has the process finished executing?
@@ -177,11 +191,17 @@ namespace core {
 		/// </summary>
 		bool HasAnyIOEvent();
 
+		/// Number of ticks until the next IO event is due, INT_MAX if none
+		int GetTicksToIOEvent();
+
 		/// <summary>
 		/// Returns the IO data that is to be handled next, and pops it from the queue
 		/// </summary>
 		ProcessIOData GetIOData();
 
+		/// Appends an IO pair after the existing ones
+		void AddIOData(ProcessIOData ioData);
+
 		/// <summary>
 		/// Returns the time left for the process to run
 		/// </summary>
@@ -200,21 +220,31 @@ namespace core {
 
 		// Returns the dynamic metadata
 		ProcessDynamicMetadata* GetDynamicMetadata();
+
+		// Returns the links of the intrusive RDY queue holding the process
+		_COLLECTION IntrusiveListHook<Process>* GetQueueHook();
 	};
+
+	// Per simulation slab of processes, forked children included
+	typedef _COLLECTION ObjectPool<Process> ProcessPool;
 }
 
 namespace collections {
-	class ProcessLinkedList : public _COLLECTION LinkedList<_CORE Process*> {
+	// Hook of the intrusive RDY queue holding a process
+	struct ProcessQueueHook {
+		IntrusiveListHook<_CORE Process>* operator()(_CORE Process* p) {
+			return p->GetQueueHook();
+		}
+	};
+
+	// RDY queue linked through the processes, O(1) unlink of any process
+	class ProcessIntrusiveList : public IntrusiveList<_CORE Process, ProcessQueueHook> {
 	public:
 		void Print(_STD wstringstream& stream);
-
-		/// <summary>
-		/// Returns the process with id=pid (optimized)
-		/// </summary>
-		_CORE Process* GetProcessWithID(int pid);
 	};
 
-	class ProcessLinkedQueue : public LinkedQueue<_CORE Process*> {
+	// FIFO process queue in a ring buffer
+	class ProcessArrayDeque : public ArrayDeque<_CORE Process*> {
 	public:
 		void Print(_STD wstringstream& stream);
 	};
@@ -247,4 +277,33 @@ namespace collections {
 			}
 		}
 	};
+
+	// Heap backed process priority queue, O(log n) enqueue/dequeue
+	template<typename Comparer>
+	class ProcessArrayPriorityQueue : public ArrayPriorityQueue<_CORE Process*, Comparer> {
+	protected:
+		using Entry = typename ArrayPriorityQueue<_CORE Process*, Comparer>::Entry;
+		using ArrayPriorityQueue<_CORE Process*, Comparer>::m_Heap;
+		using ArrayPriorityQueue<_CORE Process*, Comparer>::m_Count;
+		using ArrayPriorityQueue<_CORE Process*, Comparer>::Before;
+
+	public:
+		void Print(_STD wstringstream& stream) {
+			if (m_Count == 0) return;
+
+			//heap order isnt priority order, print a sorted copy
+			Entry* sorted = new Entry[m_Count];
+			memcpy(sorted, m_Heap, sizeof(Entry) * m_Count);
+
+			_STD sort(sorted, sorted + m_Count, [this](const Entry& a, const Entry& b) {
+				return Before(a, b);
+			});
+
+			for (int i = 0; i < m_Count; i++) {
+				stream << sorted[i].value << L", ";
+			}
+
+			delete[] sorted;
+		}
+	};
 }
\ No newline at end of file
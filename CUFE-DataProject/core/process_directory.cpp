@@ -0,0 +1,125 @@
+#include "process_directory.h"
+
+#include <cstdint>
+
+// Initial and smallest number of slots
+#define PROCESS_DIRECTORY_MIN_CAPACITY 64
+
+namespace core {
+	ProcessDirectory::ProcessDirectory() : m_Entries(0), m_Capacity(0), m_Bits(0), m_Count(0) {
+		Rehash(PROCESS_DIRECTORY_MIN_CAPACITY);
+	}
+
+	ProcessDirectory::~ProcessDirectory() {
+		if (m_Entries) {
+			delete[] m_Entries;
+		}
+	}
+
+	int ProcessDirectory::GetHomeSlot(int pid) {
+		//fibonacci hashing, the top bits of the product spread both consecutive and strided pids
+		uint32_t hash = (uint32_t)pid * 2654435769u;
+		return (int)(hash >> (32 - m_Bits));
+	}
+
+	void ProcessDirectory::Rehash(int capacity) {
+		ProcessDirectoryEntry* old = m_Entries;
+		int oldCapacity = m_Capacity;
+
+		m_Entries = new ProcessDirectoryEntry[capacity];
+		memset(m_Entries, 0, sizeof(ProcessDirectoryEntry) * capacity);
+		m_Capacity = capacity;
+
+		m_Bits = 0;
+		while ((1 << m_Bits) < capacity) {
+			m_Bits++;
+		}
+
+		if (old == 0) return;
+
+		for (int i = 0; i < oldCapacity; i++) {
+			if (old[i].proc == 0) continue;
+
+			int slot = GetHomeSlot(old[i].pid);
+			while (m_Entries[slot].proc != 0) {
+				slot = (slot + 1) & (m_Capacity - 1);
+			}
+
+			m_Entries[slot] = old[i];
+		}
+
+		delete[] old;
+	}
+
+	int ProcessDirectory::FindSlot(Process* proc) {
+		//entries sharing the pid all lie in the probe run of its home slot
+		for (int slot = GetHomeSlot(proc->GetPID()); m_Entries[slot].proc != 0; slot = (slot + 1) & (m_Capacity - 1)) {
+			if (m_Entries[slot].proc == proc) return slot;
+		}
+
+		return -1;
+	}
+
+	void ProcessDirectory::Register(Process* proc) {
+		if (FindSlot(proc) != -1) {
+			Update(proc);
+			return;
+		}
+
+		//keep the load factor under 1/2
+		if ((m_Count + 1) * 2 > m_Capacity) {
+			Rehash(m_Capacity * 2);
+		}
+
+		int pid = proc->GetPID();
+		int slot = GetHomeSlot(pid);
+		while (m_Entries[slot].proc != 0) {
+			slot = (slot + 1) & (m_Capacity - 1);
+		}
+
+		m_Entries[slot] = { proc, proc->GetOwner(), proc->GetState(), pid };
+		m_Count++;
+	}
+
+	void ProcessDirectory::Unregister(Process* proc) {
+		int slot = FindSlot(proc);
+		if (slot == -1) return;
+
+		//backward shift deletion, pull up every entry of the run that can fill the hole
+		int hole = slot;
+		for (int next = (hole + 1) & (m_Capacity - 1); m_Entries[next].proc != 0; next = (next + 1) & (m_Capacity - 1)) {
+			int home = GetHomeSlot(m_Entries[next].pid);
+
+			//the entry stays if its home lies cyclically in (hole, next]
+			bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+			if (stays) continue;
+
+			m_Entries[hole] = m_Entries[next];
+			hole = next;
+		}
+
+		memset(&m_Entries[hole], 0, sizeof(ProcessDirectoryEntry));
+		m_Count--;
+
+		//give memory back once most processes are gone
+		if (m_Capacity > PROCESS_DIRECTORY_MIN_CAPACITY && m_Count * 8 < m_Capacity) {
+			Rehash(m_Capacity / 2);
+		}
+	}
+
+	void ProcessDirectory::Update(Process* proc) {
+		int slot = FindSlot(proc);
+		if (slot == -1) return;
+
+		m_Entries[slot].owner = proc->GetOwner();
+		m_Entries[slot].state = proc->GetState();
+	}
+
+	ProcessDirectoryEntry* ProcessDirectory::GetEntry(int pid) {
+		for (int slot = GetHomeSlot(pid); m_Entries[slot].proc != 0; slot = (slot + 1) & (m_Capacity - 1)) {
+			if (m_Entries[slot].pid == pid) return &m_Entries[slot];
+		}
+
+		return 0;
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../common.h"
+#include "process.h"
+#include "states.h"
+
+namespace core {
+	/// <summary>
+	/// Where a live process currently is
+	/// </summary>
+	struct ProcessDirectoryEntry {
+		// The process, null if the slot is empty
+		Process* proc;
+
+		// The processor owning the process (RDY/RUN), null otherwise
+		Processor* owner;
+
+		// Current process state
+		ProcessState state;
+
+		// Pid the entry is keyed by
+		int pid;
+	};
+
+	/// <summary>
+	/// Scheduler wide directory of live processes keyed by pid, O(1) lookup
+	/// <para>An open addressing hash table with linear probing, sized by the live processes rather than the pid range.
+	/// Two live processes may share a pid, neither replaces the other</para>
+	/// </summary>
+	class ProcessDirectory {
+	private:
+		/// <summary>
+		/// Slots of the table, capacity is a power of 2
+		/// </summary>
+		ProcessDirectoryEntry* m_Entries;
+
+		int m_Capacity;
+
+		/// <summary>
+		/// Capacity is 2^m_Bits
+		/// </summary>
+		int m_Bits;
+
+		/// <summary>
+		/// Number of live entries
+		/// </summary>
+		int m_Count;
+
+		/// Home slot of a pid
+		int GetHomeSlot(int pid);
+
+		/// Reinserts every entry into a table of the given capacity
+		void Rehash(int capacity);
+
+		/// Returns the slot of a registered process, -1 if it isnt registered
+		int FindSlot(Process* proc);
+
+	public:
+		ProcessDirectory();
+		~ProcessDirectory();
+
+		ProcessDirectory(const ProcessDirectory&) = delete;
+		ProcessDirectory& operator=(const ProcessDirectory&) = delete;
+
+		/// <summary>
+		/// Adds a process to the directory
+		/// </summary>
+		void Register(Process* proc);
+
+		/// <summary>
+		/// Removes a process from the directory
+		/// </summary>
+		void Unregister(Process* proc);
+
+		/// <summary>
+		/// Copies the owner and state of a registered process
+		/// </summary>
+		void Update(Process* proc);
+
+		/// <summary>
+		/// Returns the entry of a live process, null if there is none
+		/// </summary>
+		ProcessDirectoryEntry* GetEntry(int pid);
+	};
+}
@@ -1,18 +1,44 @@
 #include "processor.h"
 #include "scheduler.h"
-#include "random_engine.h"
 #include "processor_fcfs.h"
 
+#include <climits>
+#include <algorithm>
+
 namespace core {
-	Processor::Processor(ProcessorType type, Scheduler* scheduler) : m_Type(type), m_Scheduler(scheduler), m_ConcurrentTimer(0), 
+	Processor::Processor(ProcessorType type, Scheduler* scheduler) : m_Type(type), m_ID(-1), m_Scheduler(scheduler), m_ConcurrentTimer(0), 
 		m_State(ProcessorState::IDLE), m_RunningProcess(0) {
 		memset(m_StateTimers, 0, 3 * sizeof(int));
 	}
 
+	void Processor::SetRandomStream(RandomStream stream) {
+		m_Random = stream;
+
+		//whether quiet timesteps peek at the next overheat must not change the other draws
+		stream.LongJump();
+		m_OverheatCountdown.SetStream(stream);
+	}
+
+	SchedulerTimer* Processor::GetCooldownTimer() {
+		return &m_CooldownTimer;
+	}
+
 	ProcessorType Processor::GetProcessorType() {
 		return m_Type;
 	}
 
+	int Processor::GetID() {
+		return m_ID;
+	}
+
+	void Processor::SetID(int id) {
+		m_ID = id;
+	}
+
+	void Processor::NotifyQueueChanged() {
+		m_Scheduler->NotifyProcessorQueueChanged(this);
+	}
+
 	int Processor::GetConcurrentTimer(bool withRunning) {
 		if (withRunning || m_RunningProcess == 0) return m_ConcurrentTimer;
 
@@ -25,6 +51,9 @@ namespace core {
 
 	void Processor::SetState(ProcessorState state) {
 		m_State = state;
+
+		//STOP processors leave the index
+		NotifyQueueChanged();
 	}
 
 	Process* Processor::GetRunningProcess() {
@@ -33,6 +62,8 @@ namespace core {
 
 	void Processor::DecrementTimer(Process* proc) {
 		m_ConcurrentTimer -= proc != 0 ? proc->GetRemainingTime() : 1;
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::TerminateProcess(Process* proc) {
@@ -44,11 +75,14 @@ namespace core {
 		//update state to TRM
 		proc->SetState(ProcessState::TRM);
 
+		m_Scheduler->TraceEvent(TraceEventType::Termination, proc, this,
+			m_Scheduler->GetSimulationInfo()->GetTimestep() - proc->GetArrivalTime());
+
 		//we are not the owner anymore
 		proc->SetOwner(0);
 
 		//move process to trm list
-		m_Scheduler->NotifyProcessTerminated(proc);
+		m_Scheduler->NotifyProcessTerminated(proc, m_Type);
 	}
 
 	bool Processor::TryMigrate(Process*& proc) {
@@ -67,6 +101,12 @@ namespace core {
 
 		//set owner incase
 		proc->SetOwner(this);
+
+		m_Scheduler->GetProcessDirectory()->Update(proc);
+
+		m_Scheduler->TraceEvent(TraceEventType::Run, proc, this, proc->GetRemainingTime());
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::TerminateRunningProcess() {
@@ -80,6 +120,8 @@ namespace core {
 
 		//update state to idle
 		m_State = ProcessorState::IDLE;
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::BlockRunningProcess() {
@@ -91,9 +133,13 @@ namespace core {
 		//update state to BLK
 		m_RunningProcess->SetState(ProcessState::BLK);
 
+		m_Scheduler->TraceEvent(TraceEventType::Block, m_RunningProcess, this, m_RunningProcess->GetRemainingTime());
+
 		//we are not the owner anymore
 		m_RunningProcess->SetOwner(0);
 
+		m_Scheduler->GetProcessDirectory()->Update(m_RunningProcess);
+
 		//move process to trm list
 		m_Scheduler->NotifyProcessBlocked(m_RunningProcess);
 
@@ -102,6 +148,8 @@ namespace core {
 
 		//update state to idle
 		m_State = ProcessorState::IDLE;
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::RequeueRunningProcess() {
@@ -110,11 +158,17 @@ namespace core {
 		//update state to RDY
 		m_RunningProcess->SetState(ProcessState::RDY);
 
+		m_Scheduler->TraceEvent(TraceEventType::Preemption, m_RunningProcess, this, m_RunningProcess->GetRemainingTime());
+
+		m_Scheduler->GetProcessDirectory()->Update(m_RunningProcess);
+
 		//no running procs now
 		m_RunningProcess = 0;
 
 		//update state to idle
 		m_State = ProcessorState::IDLE;
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::QueueProcess(Process* proc) {
@@ -126,6 +180,10 @@ namespace core {
 
 		//set owner
 		proc->SetOwner(this);
+
+		m_Scheduler->GetProcessDirectory()->Update(proc);
+
+		NotifyQueueChanged();
 	}
 
 	void Processor::Print(_STD wstringstream& stream) {
@@ -138,11 +196,6 @@ namespace core {
 	}
 
 	void Processor::UpdateStateTimer() {
-		if (m_State == ProcessorState::STOP) {
-			m_StateTimers[(int)ProcessorState::STOP]++;
-			return;
-		}
-
 		m_StateTimers[(int)(IsBusy() ? ProcessorState::BUSY : ProcessorState::IDLE)]++;
 	}
 
@@ -165,35 +218,85 @@ namespace core {
 		return denominator == 0.f ? 0.f : busyTime / (float)(busyTime + idleTime);
 	}
 
-	void Processor::ResetStateTimer(ProcessorState state) {
-		m_StateTimers[(int)state] = 0;
+	bool Processor::RollOverheat() {
+		return m_OverheatCountdown.Roll(OVERHEAT_PROB, 1000) && CanOverheat();
 	}
 
-	void Processor::CheckOverheat() {
-		int num = RandomEngine::GetInt(1, 1000);
-		if (num <= OVERHEAT_PROB && m_Scheduler->CanProcessorOverheat(m_Type)) {
-			//check if fcfs and has orphans
-			if (m_Type == ProcessorType::FCFS) {
-				if (((ProcessorFCFS*)this)->HasOrphans()) {
-					return;
-				}
+	bool Processor::CanOverheat() {
+		if (!m_Scheduler->CanProcessorOverheat(m_Type)) return false;
+
+		//check if fcfs and has orphans
+		if (m_Type == ProcessorType::FCFS) {
+			if (((ProcessorFCFS*)this)->HasOrphans()) {
+				return false;
 			}
+		}
 
+		return true;
+	}
+
+	void Processor::CheckOverheat() {
+		if (RollOverheat()) {
 			//overheat !!
 			SetState(ProcessorState::STOP);
 
+			//back to IDLE after the overheat delay, atleast a timestep later
+			int delay = _STD max(m_Scheduler->GetLoadFileInfo()->data.overheat_delay, 1);
+			m_Scheduler->GetTimers()->Schedule(&m_CooldownTimer, m_Scheduler->GetSimulationInfo()->GetTimestep() + delay);
+
+			m_Scheduler->TraceEvent(TraceEventType::Overheat, 0, this, m_Scheduler->GetLoadFileInfo()->data.overheat_delay);
+
 			PUSHCOL(COL(BLACK, WHITE));
-			LOG(L"OVERHEATING PROCESSOR");
+			LOG_INFO(Processor, L"OVERHEATING PROCESSOR");
 
 			//start migrating all
 			MigrateAllProcesses();
 
-			LOG(L"OVERHEATING DONE");
+			LOG_INFO(Processor, L"OVERHEATING DONE");
 
 			POPCOL();
 		}
 	}
 
+	int Processor::GetQuietTimesteps() {
+		//recovery is bound by the cooldown timer
+		if (m_State == ProcessorState::STOP) return INT_MAX;
+
+		int quiet = INT_MAX;
+		if (m_RunningProcess == 0) {
+			//a process in RDY gets picked on the next update
+			if (IsBusy()) return 0;
+		}
+		else {
+			//running process either finishes or requests IO
+			int ticks = _STD min(m_RunningProcess->GetRemainingTime(), m_RunningProcess->GetTicksToIOEvent());
+			quiet = ticks > 1 ? ticks - 1 : 0;
+		}
+
+		//the next overheat draw that hits, skipped over if the processor cant overheat anyway
+		int overheat = m_OverheatCountdown.GetTrialsLeft(OVERHEAT_PROB, 1000) - 1;
+		if (overheat < quiet && CanOverheat()) {
+			quiet = overheat;
+		}
+
+		return quiet;
+	}
+
+	void Processor::AdvanceQuietTimesteps(int count, int timestep) {
+		//STOP processors are left alone until their cooldown expires
+		if (m_State == ProcessorState::STOP) return;
+
+		if (m_RunningProcess != 0) {
+			m_RunningProcess->Tick(timestep, count);
+			m_ConcurrentTimer -= count;
+		}
+
+		m_StateTimers[(int)(IsBusy() ? ProcessorState::BUSY : ProcessorState::IDLE)] += count;
+
+		//every quiet timestep draws the overheat probability, hits can only land while the processor cant overheat
+		m_OverheatCountdown.Skip(OVERHEAT_PROB, 1000, count);
+	}
+
 	_STD wstring ProcessorTypeToWString(ProcessorType type) {
 		switch (type) {
 		case ProcessorType::FCFS:
@@ -207,6 +310,9 @@ namespace core {
 
 		case ProcessorType::EDF:
 			return L"EDF";
+
+		default:
+			break;
 		}
 
 		return L"";
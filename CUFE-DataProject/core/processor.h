@@ -2,6 +2,8 @@
 
 #include "states.h"
 #include "process.h"
+#include "random_engine.h"
+#include "scheduler_timer.h"
 
 #include <sstream>
 #include <functional>
@@ -14,7 +16,9 @@ namespace core {
 		FCFS,
 		SJF,
 		RR,
-		EDF
+		EDF,
+
+		MAX
 	};
 
 	/// Simple handle containing a process to be stolen, and a steal delegate
@@ -33,13 +37,26 @@ namespace core {
 		/// </summary>
 		ProcessorType m_Type;
 
+		/// Index of the processor in the scheduler
+		int m_ID;
+
 		/// <summary>
 		/// Timer to keep track of how long processes are going to run for
 		/// </summary>
 		int m_ConcurrentTimer;
 
-		/// Time spent per state
+		/// Time spent per state, STOP is left at 0
 		int m_StateTimers[3];
+
+		/// <summary>
+		/// Ticks left to the next overheat draw that hits OVERHEAT_PROB
+		/// </summary>
+		RandomCountdown m_OverheatCountdown;
+
+		/// <summary>
+		/// Expires once an overheated processor has cooled down
+		/// </summary>
+		SchedulerTimer m_CooldownTimer;
 	
 	protected:
 		/// <summary>
@@ -57,6 +74,11 @@ namespace core {
 		/// </summary>
 		Scheduler* m_Scheduler;
 
+		/// <summary>
+		/// Stream of the random events of this processor, independent of every other processor
+		/// </summary>
+		RandomStream m_Random;
+
 		/// <summary>
 		/// Terminates a process (does not alter the processor state)
 		/// </summary>
@@ -70,6 +92,15 @@ namespace core {
 
 		virtual bool IsBusy() abstract;
 
+		/// Notifies the scheduler that our queue length or state has changed
+		void NotifyQueueChanged();
+
+		/// Draws the overheat probability, returns true if the processor should overheat
+		bool RollOverheat();
+
+		/// Can the processor overheat right now, regardless of the draw?
+		bool CanOverheat();
+
 	public:
 		Processor(ProcessorType type, Scheduler* scheduler);
 
@@ -78,6 +109,20 @@ namespace core {
 		/// </summary>
 		ProcessorType GetProcessorType();
 
+		/// Index of the processor in the scheduler
+		int GetID();
+
+		/// Sets the index of the processor in the scheduler
+		void SetID(int id);
+
+		/// <summary>
+		/// Sets the stream of the random events of this processor, countdowns draw from sub streams of it
+		/// </summary>
+		virtual void SetRandomStream(RandomStream stream);
+
+		/// Timer of the overheat cooldown, scheduled while the processor is in STOP
+		SchedulerTimer* GetCooldownTimer();
+
 		/// <summary>
 		/// Returns the concurrent timer value
 		/// </summary>
@@ -140,10 +185,10 @@ namespace core {
 		/// </summary>
 		virtual void Print(_STD wstringstream& stream);
 
-		/// Updates the current state timer
+		/// Updates the BUSY or IDLE state timer, never called in STOP
 		void UpdateStateTimer();
 
-		/// Returns the applicable time for the specified state
+		/// Returns the time spent in BUSY or IDLE, STOP is bound by the cooldown timer and always 0
 		int GetStateTime(ProcessorState state);
 
 		/// Returns the processor load
@@ -152,11 +197,18 @@ namespace core {
 		/// Returns the processor utilization
 		float GetProcessorUtilization();
 
-		/// Resets the specified state's timer
-		void ResetStateTimer(ProcessorState state);
-
 		/// Checks overheat status
 		void CheckOverheat();
+
+		/// <summary>
+		/// Number of upcoming timesteps in which the processor only burns down its running process
+		/// </summary>
+		virtual int GetQuietTimesteps();
+
+		/// <summary>
+		/// Advances the processor through count quiet timesteps at once, timestep is the first of them
+		/// </summary>
+		virtual void AdvanceQuietTimesteps(int count, int timestep);
 	};
 
 	/// <summary>
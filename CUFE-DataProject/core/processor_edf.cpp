@@ -69,7 +69,7 @@ namespace core {
         //process is applicable for stealing
         *stealHandle = {
             proc,
-            [&]() -> void {
+            [this, proc]() -> void {
                 //update timer
                 DecrementTimer(proc);
 
@@ -81,6 +81,18 @@ namespace core {
         return true;
     }
 
+    int ProcessorEDF::GetQuietTimesteps() {
+        if (m_State != ProcessorState::STOP && m_RunningProcess != 0) {
+            //an earlier deadline got queued after our last update
+            Process* p = 0;
+            if (m_ReadyProcesses.Peek(&p) && p->GetDeadline() < m_RunningProcess->GetDeadline()) {
+                return 0;
+            }
+        }
+
+        return Processor::GetQuietTimesteps();
+    }
+
     void ProcessorEDF::MigrateAllProcesses() {
         if (m_RunningProcess != 0) {
             DecrementTimer(m_RunningProcess);
@@ -7,7 +7,7 @@
 namespace core {
 	class ProcessorEDF : public Processor {
 	private:
-		_COLLECTION ProcessLinkedPriorityQueue<_COLLECTION ProcessDeadlinePriority> m_ReadyProcesses;
+		_COLLECTION ProcessArrayPriorityQueue<_COLLECTION ProcessDeadlinePriority> m_ReadyProcesses;
 
 	protected:
 		/// Migrates all the processes to other processors
@@ -29,5 +29,8 @@ namespace core {
 
 		// Returns a steal handle for a process, if applicable
 		virtual bool GetStealHandle(StealHandle* stealHandle) override;
+
+		/// Quiet timesteps, none if the running process is about to be preempted
+		virtual int GetQuietTimesteps() override;
 	};
 }
\ No newline at end of file
@@ -1,10 +1,9 @@
 #include "processor_fcfs.h"
 #include "scheduler.h"
-#include "random_engine.h"
 
-namespace core {
-	_COLLECTION LinkedQueue<SigkillTimeInfo> ProcessorFCFS::ms_Sigkills;
+#include <algorithm>
 
+namespace core {
 	ProcessorFCFS::ProcessorFCFS(Scheduler* scheduler) : Processor(ProcessorType::FCFS, scheduler) {
 	}
 	
@@ -13,13 +12,9 @@ namespace core {
 			//check for migration of currently running process
 			if (!TryMigrate(m_RunningProcess)) {
 				//check for forking
-				if (m_RunningProcess->CanFork()) {
-					//generate probability
-					int num = RandomEngine::GetInt(1, 100);
-					if (num <= m_Scheduler->GetLoadFileInfo()->data.fork_prob) {
-						//fork !!!
-						m_Scheduler->ForkProcess(m_RunningProcess);
-					}
+				if (m_RunningProcess->CanFork() && RollFork()) {
+					//fork !!!
+					m_Scheduler->ForkProcess(m_RunningProcess);
 				}
 			}
 		}
@@ -33,29 +28,49 @@ namespace core {
 			//keep on picking a new process until migration doesnt occur
 			if (m_RunningProcess == 0 && m_ReadyProcesses.GetLength() > 0) {
 				//running proc should be head O(1)
-				proc = *m_ReadyProcesses[0];
+				proc = m_ReadyProcesses.GetHead();
 
 				//remove from head O(1)
-				m_ReadyProcesses.Remove(proc);
+				RemoveReadyProcess(proc);
 			}
 		} while (TryMigrate(proc));
 
 		if (proc != 0) {
 			RunProcess(proc);
 		}
+	}
 
-		LOG(L"Looking for sigkill");
+	void ProcessorFCFS::SetRandomStream(RandomStream stream) {
+		Processor::SetRandomStream(stream);
 
-		//process sigkill for FCFS -- many sigkills can occur at the same timestep
-		SigkillTimeInfo sigkill;
-		while (ms_Sigkills.Peek(&sigkill) && sigkill.time == m_Scheduler->GetSimulationInfo()->GetTimestep()) {
-			//dequeue sigkill
-			ms_Sigkills.Dequeue();
+		//the overheat countdown took the first sub stream
+		stream.LongJump();
+		stream.LongJump();
+		m_ForkCountdown.SetStream(stream);
+	}
 
-			LOGF(L"Found sigkill for proc pid=%d", sigkill.proc_pid);
+	bool ProcessorFCFS::RollFork() {
+		//forkable running processes draw the fork probability every tick
+		return m_ForkCountdown.Roll(m_Scheduler->GetLoadFileInfo()->data.fork_prob, 100);
+	}
+
+	int ProcessorFCFS::GetQuietTimesteps() {
+		int quiet = Processor::GetQuietTimesteps();
+		if (m_State == ProcessorState::STOP || m_RunningProcess == 0 || !m_RunningProcess->CanFork()) return quiet;
 
-			//process it
-			ProcessSigkill(sigkill.proc_pid);
+		//fork happens on the last of the draws left
+		int fork = m_ForkCountdown.GetTrialsLeft(m_Scheduler->GetLoadFileInfo()->data.fork_prob, 100) - 1;
+		return _STD min(quiet, fork);
+	}
+
+	void ProcessorFCFS::AdvanceQuietTimesteps(int count, int timestep) {
+		//whether the running process can fork is decided before it ticks
+		bool forkable = m_State != ProcessorState::STOP && m_RunningProcess != 0 && m_RunningProcess->CanFork();
+
+		Processor::AdvanceQuietTimesteps(count, timestep);
+
+		if (forkable) {
+			m_ForkCountdown.Skip(m_Scheduler->GetLoadFileInfo()->data.fork_prob, 100, count);
 		}
 	}
 
@@ -64,7 +79,16 @@ namespace core {
 		Processor::QueueProcess(proc);
 
 		//add to ready list
-		m_ReadyProcesses.Add(proc);
+		AddReadyProcess(proc);
+	}
+
+	void ProcessorFCFS::AddReadyProcess(Process* proc) {
+		m_ReadyProcesses.PushBack(proc);
+	}
+
+	void ProcessorFCFS::RemoveReadyProcess(Process* proc) {
+		//links live in the process
+		m_ReadyProcesses.Remove(proc);
 	}
 
 	void ProcessorFCFS::Print(_STD wstringstream& stream) {
@@ -81,10 +105,32 @@ namespace core {
 	}
 
 	void ProcessorFCFS::KillProcess(int pid) {
-		LOGF(L"Killing process with pid=%d", pid);
+		//look the process up, it must be ours
+		ProcessDirectoryEntry* entry = m_Scheduler->GetProcessDirectory()->GetEntry(pid);
+		if (entry == 0 || entry->owner != this) {
+			LOGF_DEBUG(Kill, L"Not found, ignoring kill, pid=%d", pid);
+			return;
+		}
+
+		KillProcess(entry->proc);
+	}
+
+	void ProcessorFCFS::KillProcess(Process* proc) {
+		LOGF_INFO(Kill, L"Killing process with pid=%d", proc->GetPID());
+
+		//must be ours
+		if (proc->GetOwner() != this) {
+			LOGF_DEBUG(Kill, L"Not owned, ignoring kill, pid=%d", proc->GetPID());
+			return;
+		}
+
+		//mark killed for the statistics
+		proc->GetDynamicMetadata()->killed = true;
+
+		m_Scheduler->TraceEvent(TraceEventType::Kill, proc, this, 0);
 
 		//check if it's the running process
-		if (m_RunningProcess != 0 && m_RunningProcess->GetPID() == pid) {
+		if (m_RunningProcess != 0 && m_RunningProcess == proc) {
 			//yep it is
 			TerminateRunningProcess();
 
@@ -93,11 +139,10 @@ namespace core {
 			return;
 		}
 
-		//search for it in RDY
-		Process* proc = m_ReadyProcesses.GetProcessWithID(pid);
-		if (proc != 0) {
-			//remove from ready
-			m_ReadyProcesses.Remove(proc);
+		//must be in RDY
+		if (m_ReadyProcesses.Contains(proc)) {
+			//remove from ready O(1)
+			RemoveReadyProcess(proc);
 
 			//terminate
 			TerminateProcess(proc);
@@ -108,74 +153,43 @@ namespace core {
 	}
 
 	void ProcessorFCFS::KillRandomProcess() {
-		LOG(L"Attempting to kill a random process");
+		LOG_DEBUG(Kill, L"Attempting to kill a random process");
 
 		if (m_ReadyProcesses.GetLength() == 0) {
-			LOG(L"RDY empty, cant kill");
+			LOG_DEBUG(Kill, L"RDY empty, cant kill");
 			return;
 		}
 
-		int pid = RandomEngine::GetInt(1, m_Scheduler->GetLoadFileInfo()->data.proc_count);
+		int pid = m_Random.GetInt(1, m_Scheduler->GetLoadFileInfo()->data.proc_count);
 
-		LOGF(L"Chosen pid=%d", pid);
+		LOGF_DEBUG(Kill, L"Chosen pid=%d", pid);
 
-		Process* proc = m_ReadyProcesses.GetProcessWithID(pid);
-		if (proc != 0) {
-			LOG(L"Process to kill found, removing...");
+		//only processes in our RDY list
+		ProcessDirectoryEntry* entry = m_Scheduler->GetProcessDirectory()->GetEntry(pid);
+		if (entry != 0 && entry->owner == this && m_ReadyProcesses.Contains(entry->proc)) {
+			LOG_DEBUG(Kill, L"Process to kill found, removing...");
 
-			//remove from ready
-			m_ReadyProcesses.Remove(proc);
+			Process* proc = entry->proc;
 
-			//terminate
-			TerminateProcess(proc);
-		}
-		else {
-			LOG(L"Process not found");
-		}
-	}
-
-	void ProcessorFCFS::ProcessSigkill(int pid) {
-		LOGF(L"ProcessSigkill(%d)", pid);
-
-		//nothing to do
-		if (m_RunningProcess == 0 && m_ReadyProcesses.GetLength() == 0) {
-			LOG(L"No running proc & empty RDY");
-			return;
-		}
+			//mark killed for the statistics
+			proc->GetDynamicMetadata()->killed = true;
 
-		//check for running proc first
-		if (m_RunningProcess != 0 && m_RunningProcess->GetPID() == pid) {
-			LOG(L"Running proc is kill target, terminating...");
-
-			//terminate it
-			TerminateRunningProcess();
-
-			m_Scheduler->GetStatistics()->AddStatistic(StatisticType::Kill);
-			return;
-		}
-
-		LOG(L"Looking for kill target in RDY");
-		//find proc in ready queue
-		Process* proc = m_ReadyProcesses.GetProcessWithID(pid);
-		if (proc != 0) {
-			LOG(L"Found it, killing...");
+			m_Scheduler->TraceEvent(TraceEventType::Kill, proc, this, 1);
 
 			//remove from ready
-			m_ReadyProcesses.Remove(proc);
+			RemoveReadyProcess(proc);
 
 			//terminate
 			TerminateProcess(proc);
-
-			m_Scheduler->GetStatistics()->AddStatistic(StatisticType::Kill);
 		}
 		else {
-			LOG(L"Not found, ignoring sigkill...");
+			LOG_DEBUG(Kill, L"Process not found");
 		}
 	}
 
 	void ProcessorFCFS::RequeueRunningProcess() {
 		if (m_RunningProcess != 0) {
-			m_ReadyProcesses.Add(m_RunningProcess);
+			AddReadyProcess(m_RunningProcess);
 		}
 
 		Processor::RequeueRunningProcess();
@@ -187,18 +201,18 @@ namespace core {
 		//check for any RDY process
 		if (m_ReadyProcesses.GetLength() == 0) return false;
 
-		Process* proc = *m_ReadyProcesses[0];
+		Process* proc = m_ReadyProcesses.GetHead();
 		if (proc->IsForked()) return false; //no forked processes are applicable
 
 		//process is applicable for stealing
 		*stealHandle = {
 			proc,
-			[&]() -> void {
+			[this, proc]() -> void {
 				//update timer
 				DecrementTimer(proc);
 
 				//remove from head of list
-				m_ReadyProcesses.Remove(proc);
+				RemoveReadyProcess(proc);
 			}
 		};
 
@@ -208,17 +222,12 @@ namespace core {
 	bool ProcessorFCFS::HasOrphans() {
 		if (m_RunningProcess && m_RunningProcess->IsForked()) return true;
 
-		for (int i = 0; i < m_ReadyProcesses.GetLength(); i++) {
-			Process* proc = *m_ReadyProcesses[i];
+		for (Process* proc = m_ReadyProcesses.GetHead(); proc; proc = m_ReadyProcesses.GetNext(proc)) {
 			if (proc->IsForked()) return true;
 		}
 
 		return false;
 	}
-	
-	void ProcessorFCFS::RegisterSigkillInfo(SigkillTimeInfo sigkill) {
-		ms_Sigkills.Enqueue(sigkill);
-	}
 
 	bool ProcessorFCFS::TryMigrate(Process*& proc) {
 		if (proc == 0) return false;
@@ -252,6 +261,8 @@ namespace core {
 		//remove proc
 		if (m_RunningProcess == proc) {
 			m_RunningProcess = 0;
+
+			NotifyQueueChanged();
 		}
 
 		proc = 0;
@@ -267,11 +278,10 @@ namespace core {
 			m_RunningProcess = 0;
 		}
 
-		while (m_ReadyProcesses.GetLength() > 0) {
-			Process* proc = *m_ReadyProcesses[0];
-			
+		//unlinking the head is O(1), the RDY list is drained in order
+		Process* proc;
+		while (m_ReadyProcesses.Dequeue(&proc)) {
 			DecrementTimer(proc);
-			m_ReadyProcesses.Remove(proc);
 			m_Scheduler->Schedule(proc, ProcessorType::None, this);
 		}
 	}
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "../common.h"
-#include "../collections/linked_list.h"
 #include "processor.h"
 #include "process.h"
 #include "deserializer.h"
@@ -9,17 +8,19 @@
 namespace core {
 	class ProcessorFCFS : public Processor {
 	private:
-		_COLLECTION ProcessLinkedList m_ReadyProcesses;
+		_COLLECTION ProcessIntrusiveList m_ReadyProcesses;
 
-		/// <summary>
-		/// Queue of sigkills
-		/// </summary>
-		static _COLLECTION LinkedQueue<SigkillTimeInfo> ms_Sigkills;
+		/// Ticks of a forkable running process left to the next fork
+		RandomCountdown m_ForkCountdown;
 
-		/// <summary>
-		/// Processes a sigkill
-		/// </summary>
-		void ProcessSigkill(int pid);
+		/// Appends a process to the RDY list
+		void AddReadyProcess(Process* proc);
+
+		/// Unlinks a process from anywhere in the RDY list in O(1)
+		void RemoveReadyProcess(Process* proc);
+
+		/// Draws the fork probability, returns true if the running process should fork
+		bool RollFork();
 
 	protected:
 		/// Attempt to migrate the process from this processor to another
@@ -38,9 +39,12 @@ namespace core {
 		virtual void QueueProcess(Process* proc) override;
 		virtual void Print(_STD wstringstream& stream) override;
 
-		// Kills a process with the specified pid
+		// Kills a process with the specified pid, for sigkills
 		void KillProcess(int pid);
 
+		// Kills a process owned by this processor, pids are not unique so cascades kill by pointer
+		void KillProcess(Process* proc);
+
 		/// <summary>
 		/// Attempts to kill a random process in the RDY list
 		/// </summary>
@@ -57,9 +61,13 @@ namespace core {
 		/// Does the processor contain orphans?
 		bool HasOrphans();
 
-		/// <summary>
-		/// Queues a process sigkill
-		/// </summary>
-		static void RegisterSigkillInfo(SigkillTimeInfo sigkill);
+		/// Forks draw from their own sub stream too
+		virtual void SetRandomStream(RandomStream stream) override;
+
+		/// Quiet timesteps end before the running process forks
+		virtual int GetQuietTimesteps() override;
+
+		/// Advances the fork draws of the running process too
+		virtual void AdvanceQuietTimesteps(int count, int timestep) override;
 	};
 }
\ No newline at end of file
@@ -1,18 +1,21 @@
 #include "processor_rr.h"
 #include "scheduler.h"
 
+#include <algorithm>
+
 namespace core {
-	ProcessorRR::ProcessorRR(Scheduler* scheduler) : Processor(ProcessorType::RR, scheduler), m_ProcessStartTicks(0) {
+	ProcessorRR::ProcessorRR(Scheduler* scheduler) : Processor(ProcessorType::RR, scheduler) {
 	}
 
 	void ProcessorRR::ScheduleAlgo() {
+		SchedulerTimerWheel* timers = m_Scheduler->GetTimers();
+
 		//check for Time Slice
 		if (m_RunningProcess != 0) {
 			//check for migration of currently running process
 			if (!TryMigrate(m_RunningProcess)) {
-				int procTicks = m_RunningProcess->GetTicks();
-				if (procTicks > m_ProcessStartTicks && procTicks % m_Scheduler->GetLoadFileInfo()->data.rr_timeslice == 0) {
-					LOG(L"Process reached RR slice, requeuing...");
+				if (timers->IsExpired(&m_SliceTimer)) {
+					LOG_TRACE(Processor, L"Process reached RR slice, requeuing...");
 
 					//remove process
 					RequeueRunningProcess();
@@ -36,10 +39,16 @@ namespace core {
 			//run it
 			RunProcess(proc);
 
-			//set tick start
-			m_ProcessStartTicks = proc->GetTicks();
+			//the slice ends once the ticks of the process reach the next multiple of the timeslice
+			int startTicks = proc->GetTicks();
+			int slice = m_Scheduler->GetLoadFileInfo()->data.rr_timeslice;
+			timers->Schedule(&m_SliceTimer, m_Scheduler->GetSimulationInfo()->GetTimestep() + slice - startTicks % slice);
 
-			LOGF(L"RR new process, proc star ticks=%d", m_ProcessStartTicks);
+			LOGF_TRACE(Processor, L"RR new process, proc star ticks=%d", startTicks);
+		}
+		else if (m_RunningProcess == 0) {
+			//the process left before its slice ended
+			timers->Cancel(&m_SliceTimer);
 		}
 	}
 
@@ -84,7 +93,7 @@ namespace core {
 		//process is applicable for stealing
 		*stealHandle = {
 			proc,
-			[&]() -> void {
+			[this, proc]() -> void {
 				//update timer
 				DecrementTimer(proc);
 
@@ -96,6 +105,20 @@ namespace core {
 		return true;
 	}
 
+	int ProcessorRR::GetQuietTimesteps() {
+		int quiet = Processor::GetQuietTimesteps();
+		if (m_State == ProcessorState::STOP || m_RunningProcess == 0) return quiet;
+
+		LoadFileInfo* fileInfo = m_Scheduler->GetLoadFileInfo();
+
+		//migration once remaining time drops below rtf
+		if (!m_RunningProcess->IsForked() && fileInfo->data.num_processors_sjf > 0 && m_Scheduler->GetNumberOfActiveProcessors(ProcessorType::SJF) > 0) {
+			quiet = _STD min(quiet, m_RunningProcess->GetRemainingTime() - fileInfo->data.rtf);
+		}
+
+		return quiet > 0 ? quiet : 0;
+	}
+
 	bool ProcessorRR::TryMigrate(Process*& proc) {
 		if (proc == 0) return false;
 
@@ -126,6 +149,8 @@ namespace core {
 		//remove proc
 		if (m_RunningProcess == proc) {
 			m_RunningProcess = 0;
+
+			NotifyQueueChanged();
 		}
 
 		proc = 0;
@@ -141,6 +166,8 @@ namespace core {
 			m_RunningProcess = 0;
 		}
 
+		m_Scheduler->GetTimers()->Cancel(&m_SliceTimer);
+
 		Process* proc;
 		while (m_ReadyProcesses.Dequeue(&proc)) {
 			DecrementTimer(proc);
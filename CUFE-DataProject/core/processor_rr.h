@@ -11,12 +11,12 @@ namespace core {
 		/// <summary>
 		/// RR ready queue
 		/// </summary>
-		_COLLECTION ProcessLinkedQueue m_ReadyProcesses;
+		_COLLECTION ProcessArrayDeque m_ReadyProcesses;
 
 		/// <summary>
-		/// Number of ticks at the time of running the process
+		/// Expires once the running process used up its time slice
 		/// </summary>
-		int m_ProcessStartTicks;
+		SchedulerTimer m_SliceTimer;
 
 	protected:
 		/// Attempt to migrate the process from this processor to another
@@ -41,5 +41,8 @@ namespace core {
 
 		// Returns a steal handle for a process, if applicable
 		virtual bool GetStealHandle(StealHandle* stealHandle) override;
+
+		/// Quiet timesteps, also bounded by RTF migration
+		virtual int GetQuietTimesteps() override;
 	};
 }
\ No newline at end of file
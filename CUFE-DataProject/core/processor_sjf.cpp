@@ -47,7 +47,7 @@ namespace core {
 		//process is applicable for stealing
 		*stealHandle = {
 			proc,
-			[&]() -> void {
+			[this, proc]() -> void {
 				//update timer
 				DecrementTimer(proc);
 
@@ -7,7 +7,7 @@
 namespace core {
 	class ProcessorSJF : public Processor {
 	private:
-		_COLLECTION ProcessLinkedPriorityQueue<_COLLECTION ProcessRemainingTimePriority> m_ReadyProcesses;
+		_COLLECTION ProcessArrayPriorityQueue<_COLLECTION ProcessRemainingTimePriority> m_ReadyProcesses;
 
 	protected:
 		/// Migrates all the processes to other processors
@@ -1,25 +1,125 @@
 #include "random_engine.h"
 
+#include <climits>
+#include <cmath>
+
 namespace core {
-	_STD mt19937* RandomEngine::ms_Generator = 0;
+	RandomStream::RandomStream() {
+		Seed(0);
+	}
+
+	void RandomStream::Seed(uint64_t seed) {
+		//splitmix64, never yields an all zero state
+		for (int i = 0; i < 4; i++) {
+			uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			m_State[i] = z ^ (z >> 31);
+		}
+	}
+
+	void RandomStream::Jump() {
+		static const uint64_t jump[] = {
+			0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+		};
+
+		Jump(jump);
+	}
+
+	void RandomStream::LongJump() {
+		static const uint64_t longJump[] = {
+			0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull
+		};
+
+		Jump(longJump);
+	}
 
-	void RandomEngine::Initialize() {
+	void RandomStream::Jump(const uint64_t* polynomial) {
+		uint64_t state[4] = { 0, 0, 0, 0 };
+
+		for (int i = 0; i < 4; i++) {
+			for (int bit = 0; bit < 64; bit++) {
+				if (polynomial[i] & (1ull << bit)) {
+					state[0] ^= m_State[0];
+					state[1] ^= m_State[1];
+					state[2] ^= m_State[2];
+					state[3] ^= m_State[3];
+				}
+
+				Next();
+			}
+		}
+
+		for (int i = 0; i < 4; i++) {
+			m_State[i] = state[i];
+		}
+	}
+
+	int RandomStream::GetGeometric(int chance, int outOf) {
+		if (chance <= 0) return INT_MAX;
+		if (chance >= outOf) return 1;
+
+		//uniform in (0, 1], log never sees a zero
+		double uniform = ((Next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+		double trials = _STD floor(_STD log(uniform) / _STD log1p(-(double)chance / outOf)) + 1.0;
+
+		return trials >= INT_MAX ? INT_MAX : (int)trials;
+	}
+
+	RandomCountdown::RandomCountdown() : m_TrialsLeft(0) {
+	}
+
+	void RandomCountdown::SetStream(const RandomStream& random) {
+		m_Random = random;
+		m_TrialsLeft = 0;
+	}
+
+	bool RandomCountdown::Roll(int chance, int outOf) {
+		if (GetTrialsLeft(chance, outOf) == INT_MAX) return false;
+
+		//sample the next success once this one is used up
+		return --m_TrialsLeft == 0;
+	}
+
+	int RandomCountdown::GetTrialsLeft(int chance, int outOf) {
+		if (m_TrialsLeft == 0) {
+			m_TrialsLeft = m_Random.GetGeometric(chance, outOf);
+		}
+
+		return m_TrialsLeft;
+	}
+
+	void RandomCountdown::Skip(int chance, int outOf, int count) {
+		while (count > 0) {
+			int left = GetTrialsLeft(chance, outOf);
+			if (left == INT_MAX) return;
+
+			int step = count < left ? count : left;
+			m_TrialsLeft -= step;
+			count -= step;
+		}
+	}
+
+	RandomEngine::RandomEngine() {
 		//create device
 		_STD random_device device;
 
-		//init gen
-		ms_Generator = new _STD mt19937(device());
+		SetSeed(((uint64_t)device() << 32) | device());
 	}
 
-	int RandomEngine::GetInt(int min, int max) {
-		//create dist and use it
-		_STD uniform_int_distribution<> distribution(min, max);
-		return distribution(*ms_Generator);
+	void RandomEngine::SetSeed(uint64_t seed) {
+		m_Seed = seed;
+		m_NextStream.Seed(seed);
 	}
 
-	void RandomEngine::Clean() {
-		if (ms_Generator != 0) {
-			delete ms_Generator;
-		}
+	uint64_t RandomEngine::GetSeed() {
+		return m_Seed;
+	}
+
+	RandomStream RandomEngine::CreateStream() {
+		RandomStream stream = m_NextStream;
+		m_NextStream.Jump();
+
+		return stream;
 	}
 }
\ No newline at end of file
@@ -1,29 +1,153 @@
 #pragma once
 
 #include <random>
+#include <cstdint>
 
 namespace core {
 	/// <summary>
-	/// Random engine based on the mersenne twister engine
+	/// A xoshiro256** generator, small enough to copy and split into independent streams with Jump
 	/// </summary>
-	class RandomEngine {
+	class RandomStream {
 	private:
-		static _STD mt19937* ms_Generator;
+		uint64_t m_State[4];
+
+		static uint64_t RotateLeft(uint64_t x, int k) {
+			return (x << k) | (x >> (64 - k));
+		}
+
+		/// Advances the stream by the jump polynomial of 4 words
+		void Jump(const uint64_t* polynomial);
 
 	public:
+		RandomStream();
+
 		/// <summary>
-		/// Initializes the random engine
+		/// Seeds the state through splitmix64, so nearby seeds give unrelated states
 		/// </summary>
-		static void Initialize();
+		void Seed(uint64_t seed);
+
+		/// <summary>
+		/// Returns the next 64 random bits
+		/// </summary>
+		uint64_t Next() {
+			uint64_t result = RotateLeft(m_State[1] * 5, 7) * 9;
+			uint64_t t = m_State[1] << 17;
+
+			m_State[2] ^= m_State[0];
+			m_State[3] ^= m_State[1];
+			m_State[1] ^= m_State[2];
+			m_State[0] ^= m_State[3];
+
+			m_State[2] ^= t;
+			m_State[3] = RotateLeft(m_State[3], 45);
+
+			return result;
+		}
 
 		/// <summary>
 		/// Returns a random between min and max inclusive
+		/// <para>Multiply and shift instead of a modulo, the rare biased draws are rejected (Lemire)</para>
+		/// </summary>
+		int GetInt(int min, int max) {
+			uint32_t range = (uint32_t)(max - min) + 1;
+
+			uint64_t m = (Next() >> 32) * range;
+			uint32_t low = (uint32_t)m;
+
+			if (low < range) {
+				uint32_t threshold = (0u - range) % range;
+				while (low < threshold) {
+					m = (Next() >> 32) * range;
+					low = (uint32_t)m;
+				}
+			}
+
+			return min + (int)(m >> 32);
+		}
+
+		/// <summary>
+		/// Returns the number of trials up to and including the first success, each trial succeeding with chance out of outOf
+		/// <para>Inverts the geometric distribution, a single draw stands in for a draw per trial. INT_MAX if chance is 0</para>
+		/// </summary>
+		int GetGeometric(int chance, int outOf);
+
+		/// <summary>
+		/// Advances the stream by 2^128 draws, streams a jump apart never overlap
+		/// </summary>
+		void Jump();
+
+		/// <summary>
+		/// Advances the stream by 2^192 draws, splits a stream into sub streams that never meet the streams made with Jump
+		/// </summary>
+		void LongJump();
+	};
+
+	/// <summary>
+	/// A chance rolled once per tick, kept as the number of trials left to its next success
+	/// <para>Successes land on the same ticks in distribution as a draw per tick, with one draw per success</para>
+	/// </summary>
+	class RandomCountdown {
+	private:
+		/// Stream of the samples, owned so that when they are drawn never shifts any other draw
+		RandomStream m_Random;
+
+		/// Trials up to and including the next success, 0 if not sampled yet
+		int m_TrialsLeft;
+
+	public:
+		RandomCountdown();
+
+		/// <summary>
+		/// Sets the stream the successes are sampled from
+		/// </summary>
+		void SetStream(const RandomStream& random);
+
+		/// <summary>
+		/// Runs a single trial, returns true if it succeeds
+		/// </summary>
+		bool Roll(int chance, int outOf);
+
+		/// <summary>
+		/// Number of trials up to and including the next success, INT_MAX if there is none
+		/// </summary>
+		int GetTrialsLeft(int chance, int outOf);
+
+		/// <summary>
+		/// Runs count trials at once, their successes are discarded
+		/// </summary>
+		void Skip(int chance, int outOf, int count);
+	};
+
+	/// <summary>
+	/// Hands out independent random streams derived from a single seed
+	/// <para>Every scheduler owns one, a run is reproducible from its seed as long as the streams are created in the same order</para>
+	/// </summary>
+	class RandomEngine {
+	private:
+		uint64_t m_Seed;
+
+		/// Stream returned by the next CreateStream
+		RandomStream m_NextStream;
+
+	public:
+		/// <summary>
+		/// Seeds the engine from the random device
+		/// </summary>
+		RandomEngine();
+
+		/// <summary>
+		/// Reseeds the engine, streams are created from the start of the new seed
+		/// </summary>
+		void SetSeed(uint64_t seed);
+
+		/// <summary>
+		/// Seed the streams are derived from
 		/// </summary>
-		static int GetInt(int min, int max);
+		uint64_t GetSeed();
 
 		/// <summary>
-		/// Cleans up the engine
+		/// Returns the next independent stream
 		/// </summary>
-		static void Clean();
+		RandomStream CreateStream();
 	};
 }
\ No newline at end of file
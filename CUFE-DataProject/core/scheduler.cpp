@@ -5,11 +5,42 @@
 #include "processor_rr.h"
 #include "processor_edf.h"
 #include "random_engine.h"
+#include "../utils/output_file.h"
+
+#include <climits>
+#include <algorithm>
 
 namespace core {
-	Scheduler::Scheduler() : m_View(this, &m_UI), m_Logger(50, this), m_Statistics(this) {
+	/// Replaces the simulation parameters of a loaded file with the non negative fields of overrides
+	static void ApplyParameterOverrides(DeserializerData& data, const DeserializerData* overrides) {
+		const int fieldCount = 10;
+
+		int* fields[fieldCount] = {
+			&data.num_processors_fcfs, &data.num_processors_sjf, &data.num_processors_rr, &data.num_processors_edf,
+			&data.rr_timeslice, &data.rtf, &data.maxw, &data.stl, &data.fork_prob, &data.overheat_delay
+		};
+
+		const int* values[fieldCount] = {
+			&overrides->num_processors_fcfs, &overrides->num_processors_sjf, &overrides->num_processors_rr, &overrides->num_processors_edf,
+			&overrides->rr_timeslice, &overrides->rtf, &overrides->maxw, &overrides->stl, &overrides->fork_prob, &overrides->overheat_delay
+		};
+
+		for (int i = 0; i < fieldCount; i++) {
+			if (*values[i] >= 0) {
+				*fields[i] = *values[i];
+			}
+		}
+	}
+
+	Scheduler::Scheduler() :
+#ifndef HEADLESS
+		m_View(this, &m_UI),
+#endif
+		m_LastForkedPID(0), m_Deserializer(0), m_LoadThreads(1), m_Logger(LOG_MAX_MESSAGES, this), m_Statistics(this), m_OutputFilename("output.txt") {
+#ifndef HEADLESS
 		//initialize ui controller
 		m_UI.Initialize(APP_NAME, _UTIL Vector2(APP_SIZE_WIDTH, APP_SIZE_HEIGHT), _STD bind(&SchedulerView::UICallback, &m_View));
+#endif
 
 		//zero out load file info
 		memset(&m_LoadFileInfo, 0, sizeof(LoadFileInfo));
@@ -23,51 +54,87 @@ namespace core {
 		for (int i = 0; i < m_Processors.GetLength(); i++) {
 			delete *m_Processors[i];
 		}
+
+		if (m_Deserializer != 0) {
+			delete m_Deserializer;
+		}
 	}
 
 	Processor* Scheduler::GetProcessorWithShortestQueue(ProcessorType processorType, Processor* exclude) {
-		Processor* proc = 0;
-		int val = 0;
+		//suspended processors are never in the index, we cant queue obviously
+		_COLLECTION IndexedHeap<_STD less<int>>* index = &m_ShortestQueueIndex[(int)processorType];
 
-		for (int i = 0; i < m_Processors.GetLength(); i++) {
-			Processor* cur = *m_Processors[i];
+		int id;
+		if (!index->Peek(&id)) return 0;
 
-			if (processorType != ProcessorType::None && processorType != cur->GetProcessorType()) {
-				continue;
-			}
+		if (exclude == 0 || id != exclude->GetID()) {
+			return *m_Processors[id];
+		}
 
-			//if we are suspended, we cant queue obviously
-			if (cur->GetState() == ProcessorState::STOP || cur == exclude) {
-				continue;
-			}
+		//take excluded processor out temporarily, and look at the runner up
+		int key = index->GetKey(id);
+		index->Remove(id);
 
-			if (proc == 0 || cur->GetConcurrentTimer(false) < val) {
-				proc = cur;
-				val = cur->GetConcurrentTimer(false);
-			}
-		}
+		Processor* proc = index->Peek(&id) ? *m_Processors[id] : 0;
+
+		index->Set(exclude->GetID(), key);
 
 		return proc;
 	}
 
+	void Scheduler::AddProcessor(Processor* processor) {
+		processor->SetID(m_Processors.GetLength());
+		m_Processors.Add(processor);
+
+		//streams are handed out in processor order, a seed always maps to the same stream per processor
+		processor->SetRandomStream(m_RandomEngine.CreateStream());
+
+		m_ChromeTrace.AddProcessorTrack(processor);
+
+		NotifyProcessorQueueChanged(processor);
+	}
+
+	void Scheduler::NotifyProcessorQueueChanged(Processor* processor) {
+		int id = processor->GetID();
+		if (id == -1) return; //not added yet
+
+		_COLLECTION IndexedHeap<_STD less<int>>* typeIndex = &m_ShortestQueueIndex[(int)processor->GetProcessorType()];
+		_COLLECTION IndexedHeap<_STD less<int>>* globalIndex = &m_ShortestQueueIndex[(int)ProcessorType::None];
+
+		if (processor->GetState() == ProcessorState::STOP) {
+			typeIndex->Remove(id);
+			globalIndex->Remove(id);
+			m_LongestQueueIndex.Remove(id);
+			return;
+		}
+
+		//remaining time without running proc
+		int time = processor->GetConcurrentTimer(false);
+
+		typeIndex->Set(id, time);
+		globalIndex->Set(id, time);
+		m_LongestQueueIndex.Set(id, time);
+	}
+
 	void Scheduler::UpdateIO() {
-		LOG(L"Updating IO...");
+		LOG_TRACE(IO, L"Updating IO...");
 
 		//handle current execution
 		if (m_IOMutex.owner != 0) {
-			//decrement duration
-			m_IOMutex.io_data.duration--;
-
-			LOGF(L"Mutex owner exists, pid=%d, dur=%d", m_IOMutex.owner->GetPID(), m_IOMutex.io_data.duration);
+			LOGF_TRACE(IO, L"Mutex owner exists, pid=%d, dur=%d", m_IOMutex.owner->GetPID(), m_Timers.GetDeadline(&m_IOTimer) - m_SimulationInfo.GetTimestep());
 
 			//we have finished
-			if (m_IOMutex.io_data.duration == 0) {
-				LOG(L"Time up, rescheduling mutex owner");
+			if (m_Timers.IsExpired(&m_IOTimer)) {
+				LOG_DEBUG(IO, L"Time up, rescheduling mutex owner");
+
+				m_Timers.Cancel(&m_IOTimer);
+
+				TraceEvent(TraceEventType::IORelease, m_IOMutex.owner, 0);
 
 				//process should be scheduled again
 				Schedule(m_IOMutex.owner);
 
-				LOG(L"Releasing mutex");
+				LOG_DEBUG(IO, L"Releasing mutex");
 
 				//clean mutex
 				memset(&m_IOMutex, 0, sizeof(IOMutex));
@@ -76,56 +143,98 @@ namespace core {
 
 		//check for another IO operation
 		if (m_IOMutex.owner == 0) {
-			LOG(L"Finding BLK proc for mutex");
+			LOG_TRACE(IO, L"Finding BLK proc for mutex");
 
 			//find potential owner in BLK list
 			if (m_BlockedProcesses.Dequeue(&m_IOMutex.owner)) {
 				m_IOMutex.io_data = m_IOMutex.owner->GetIOData();
 
-				LOGF(L"Acquiring mutex, pid=%d, dur=%d", m_IOMutex.owner->GetPID(), m_IOMutex.io_data.duration);
+				//done once the duration has passed
+				m_Timers.Schedule(&m_IOTimer, m_SimulationInfo.GetTimestep() + m_IOMutex.io_data.duration);
+
+				LOGF_DEBUG(IO, L"Acquiring mutex, pid=%d, dur=%d", m_IOMutex.owner->GetPID(), m_IOMutex.io_data.duration);
+
+				TraceEvent(TraceEventType::IOGrant, m_IOMutex.owner, 0, m_IOMutex.io_data.duration);
 			}
 		}
 	}
 
+	void Scheduler::UpdateSigkills() {
+		int ts = m_SimulationInfo.GetTimestep();
+
+		//many sigkills can occur at the same timestep
+		SigkillTimeInfo sigkill;
+		while (m_Sigkills.Peek(&sigkill) && sigkill.time <= ts) {
+			//dequeue sigkill
+			m_Sigkills.Dequeue();
+
+			//keep the window full
+			StreamInput();
+
+			LOGF_INFO(Kill, L"Found sigkill for proc pid=%d", sigkill.proc_pid);
+
+			//victim must be in RDY/RUN of a FCFS processor
+			ProcessDirectoryEntry* entry = m_ProcessDirectory.GetEntry(sigkill.proc_pid);
+			if (entry == 0 || entry->owner == 0 || entry->owner->GetProcessorType() != ProcessorType::FCFS) {
+				LOG_DEBUG(Kill, L"Not found, ignoring sigkill...");
+				continue;
+			}
+
+			((ProcessorFCFS*)entry->owner)->KillProcess(sigkill.proc_pid);
+		}
+	}
+
+	void Scheduler::StreamInput() {
+		if (m_Deserializer == 0) return;
+
+		//arrivals are sorted by AT, so the head of the window is always the next arrival
+		Process* proc;
+		while (m_NewProcesses.GetLength() < STREAM_LOOKAHEAD && m_Deserializer->ReadProcess(&proc, &m_ProcessPool)) {
+			m_NewProcesses.Enqueue(proc);
+			m_ProcessDirectory.Register(proc);
+		}
+
+		SigkillTimeInfo sigkill;
+		while (m_Sigkills.GetLength() < STREAM_LOOKAHEAD && m_Deserializer->ReadSigkill(&sigkill)) {
+			m_Sigkills.Enqueue(sigkill);
+		}
+	}
+
 	void Scheduler::UpdateProcessor(Processor* processor) {
 		//currently running process is not null, check for completion
 
 		//only update processor if it's not in STOP
 		if (processor->GetState() == ProcessorState::STOP) {
-			//check stop timer
-			processor->UpdateStateTimer();
+			//nothing to do until the cooldown expires
+			SchedulerTimer* cooldown = processor->GetCooldownTimer();
+			if (!m_Timers.IsExpired(cooldown)) return;
 
-			//reset timer if we're done
-			if (processor->GetStateTime(ProcessorState::STOP) >= m_LoadFileInfo.data.overheat_delay) {
-				processor->ResetStateTimer(ProcessorState::STOP);
+			m_Timers.Cancel(cooldown);
 
-				//go back to idle
-				processor->SetState(ProcessorState::IDLE);
-			}
-			else 
-				return; //only exit if we are still in STOP
+			//go back to idle
+			processor->SetState(ProcessorState::IDLE);
 		}
 
 		Process* runningProc = processor->GetRunningProcess();
 		if (runningProc != 0) {
 			runningProc->Tick(m_SimulationInfo.GetTimestep());
 
-			LOGF(L"Running proc id=%d, ticks=%d", runningProc->GetPID(), runningProc->GetTicks());
+			LOGF_TRACE(Processor, L"Running proc id=%d, ticks=%d", runningProc->GetPID(), runningProc->GetTicks());
 
 			//decrement timer by 1 tick
 			processor->DecrementTimer();
 
-			LOGF(L"Processor time left=%d", processor->GetConcurrentTimer());
+			LOGF_TRACE(Processor, L"Processor time left=%d", processor->GetConcurrentTimer());
 
-			LOGF(L"IsDone=%s, HasIOEvent=%s", BOOL_TO_WSTR(runningProc->IsDone()), BOOL_TO_WSTR(runningProc->HasIOEvent()));
+			LOGF_TRACE(Processor, L"IsDone=%s, HasIOEvent=%s", BOOL_TO_WSTR(runningProc->IsDone()), BOOL_TO_WSTR(runningProc->HasIOEvent()));
 
 			//check if proc has finished executing
 			if (runningProc->IsDone()) {
-				LOG(L"Terminate current proc requested (isdone=true)");
+				LOG_DEBUG(Processor, L"Terminate current proc requested (isdone=true)");
 				processor->TerminateRunningProcess();
 			}
 			else if (runningProc->HasIOEvent()) { //check for IO
-				LOG(L"Terminate current proc requested (hasioevent=true)");
+				LOG_DEBUG(Processor, L"Terminate current proc requested (hasioevent=true)");
 
 				//block process
 				processor->BlockRunningProcess();
@@ -143,22 +252,46 @@ namespace core {
 	}
 
 	void Scheduler::Terminate() {
-		LOG(L"Terminating scheduler...");
+		LOG_INFO(Scheduler, L"Terminating scheduler...");
 
 		m_Statistics.SetLastTime(m_SimulationInfo.GetTimestep());
 
 		//done, stop the simulation
 		m_SimulationInfo.Stop();
+#ifndef HEADLESS
 		m_View.NotifyStopped();
+#endif
+
+		LOG_INFO(Scheduler, L"Writing stats...");
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::Statistics);
+			if (!m_OutputFilename.empty()) {
+				m_Statistics.WriteToFile(&m_Processors, m_OutputFilename);
+			}
+		}
 
-		LOG(L"Writing stats...");
-		m_Statistics.WriteToFile(&m_Processors, "output.txt");
-		LOG(L"DONE");
+		//the terminating update itself isnt part of the totals, output.txt -> output_profile.txt
+		if (m_UpdateProfiler.IsEnabled() && !m_OutputFilename.empty()) {
+			m_UpdateProfiler.WriteToFile(_UTIL GetSidecarFilename(m_OutputFilename, "_profile.txt"));
+		}
+
+		//write out the remaining events
+		m_EventTrace.Close();
+		m_ChromeTrace.Close();
+		LOG_INFO(Scheduler, L"DONE");
 	}
 
 	void Scheduler::UpdateWorkStealing() {
-		//check for STL time
-		if (m_SimulationInfo.GetTimestep() % m_LoadFileInfo.data.stl != 0) return;
+		//check for STL time, the timer is never scheduled while stealing is disabled
+		if (!m_Timers.IsExpired(&m_StealTimer)) return;
+
+		//STL timesteps are the multiples of stl
+		int ts = m_SimulationInfo.GetTimestep();
+		int deadline = m_Timers.GetDeadline(&m_StealTimer);
+		m_Timers.Schedule(&m_StealTimer, ts - ts % m_LoadFileInfo.data.stl + m_LoadFileInfo.data.stl);
+
+		//no update ran at the deadline (timestep 0 in silent mode), only realign
+		if (deadline != ts) return;
 
 		if (m_Processors.GetLength() <= 1) {
 			//no work stealing for such time
@@ -166,7 +299,7 @@ namespace core {
 		}
 
 		PUSHCOL(COL(DARK_BLUE, WHITE));
-		LOG(L"Updating Work Stealing");
+		LOG_TRACE(Steal, L"Updating Work Stealing");
 
 		//get longest queue and shortest queue
 		struct {
@@ -176,28 +309,20 @@ namespace core {
 			int id; //for debug
 		} min = { 0, INT_MAX }, max = { 0, INT_MIN };
 
-		for (int i = 0; i < m_Processors.GetLength(); i++) {
-			Processor* cur = *m_Processors[i];
-			
-			//get remaining time without running proc
-			int time = cur->GetConcurrentTimer(false);
-
-			if (min.processor == 0 || min.time > time) {
-				min.processor = cur;
-				min.time = time;
-				min.id = i + 1;
-			}
+		int minID, maxID;
+		if (m_ShortestQueueIndex[(int)ProcessorType::None].Peek(&minID) && m_LongestQueueIndex.Peek(&maxID)) {
+			min.processor = *m_Processors[minID];
+			min.time = min.processor->GetConcurrentTimer(false);
+			min.id = minID + 1;
 
-			if (max.processor == 0 || max.time < time) {
-				max.processor = cur;
-				max.time = time;
-				max.id = i + 1;
-			}
+			max.processor = *m_Processors[maxID];
+			max.time = max.processor->GetConcurrentTimer(false);
+			max.id = maxID + 1;
 		}
 
 		//check if min = max
 		if (min.processor != max.processor) {
-			LOGF(L"Entering stealing, MIN=%d, MAX=%d", min.id, max.id);
+			LOGF_DEBUG(Steal, L"Entering stealing, MIN=%d, MAX=%d", min.id, max.id);
 
 			//debug
 			int stealCount = 0;
@@ -206,10 +331,10 @@ namespace core {
 			while (true) {
 				//calc steal limit
 				float stealLimit = (max.time - min.time) / (float)max.time;
-				LOGF(L"StealLimit=%.2f%%", stealLimit * 100.f);
+				LOGF_DEBUG(Steal, L"StealLimit=%.2f%%", stealLimit * 100.f);
 				if (stealLimit <= 0.4f) {
 					//stealLimit isnt greater than 40%, no stealing
-					LOG(L"Exiting stealing, low limit");
+					LOG_DEBUG(Steal, L"Exiting stealing, low limit");
 					break;
 				}
 
@@ -218,7 +343,7 @@ namespace core {
 				//get steal handle
 				StealHandle handle;
 				if (!max.processor->GetStealHandle(&handle)) {
-					LOG(L"Cannot obtain a steal handle, exiting...");
+					LOG_DEBUG(Steal, L"Cannot obtain a steal handle, exiting...");
 					break;
 				}
 
@@ -229,6 +354,8 @@ namespace core {
 				//queue process
 				min.processor->QueueProcess(handle.process);
 
+				TraceEvent(TraceEventType::Steal, handle.process, max.processor, min.processor->GetID());
+
 				//m_SimulationInfo.SetMode(SimulationMode::Interactive);
 
 				//update min, max times
@@ -238,7 +365,7 @@ namespace core {
 				//increment debug counter
 				stealCount++;
 
-				LOGF(L"Executed handle, stole pid=%d", handle.process->GetPID());
+				LOGF_DEBUG(Steal, L"Executed handle, stole pid=%d", handle.process->GetPID());
 
 				//increment statistic
 				ProcessDynamicMetadata* metadata = handle.process->GetDynamicMetadata();
@@ -250,24 +377,77 @@ namespace core {
 				}
 			}
 
-			LOGF(L"Steal finished, count=%d", stealCount);
+			LOGF_DEBUG(Steal, L"Steal finished, count=%d", stealCount);
 		}
 
-		LOG(L"Working stealing done");
+		LOG_TRACE(Steal, L"Working stealing done");
 		POPCOL();
 	}
 
+	int Scheduler::GetQuietTimesteps() {
+		int ts = m_SimulationInfo.GetTimestep();
+		int quiet = INT_MAX;
+
+		//next arrival
+		Process* proc = 0;
+		if (m_NewProcesses.Peek(&proc) && proc->GetArrivalTime() >= ts) {
+			quiet = _STD min(quiet, proc->GetArrivalTime() - ts);
+		}
+
+		//next sigkill
+		SigkillTimeInfo sigkill;
+		if (m_Sigkills.Peek(&sigkill) && sigkill.time >= ts) {
+			quiet = _STD min(quiet, sigkill.time - ts);
+		}
+
+		//a BLK process acquires the mutex on the next update
+		if (m_IOMutex.owner == 0 && !m_BlockedProcesses.IsEmpty()) {
+			return 0;
+		}
+
+		//IO completion, STL, RR slices and cooldowns
+		quiet = _STD min(quiet, _STD max(m_Timers.GetNextDeadline() - ts, 0));
+
+		//processors finishing, requesting IO, migrating, forking or overheating
+		for (int i = 0; i < m_Processors.GetLength() && quiet > 0; i++) {
+			quiet = _STD min(quiet, (*m_Processors[i])->GetQuietTimesteps());
+		}
+
+		return quiet;
+	}
+
+	void Scheduler::SkipQuietTimesteps() {
+		//processors stop their quiet timesteps right before their next fork or overheat, nothing is drawn here
+		int count = GetQuietTimesteps();
+
+		//nothing is ever going to happen, keep ticking normally
+		if (count == 0 || count == INT_MAX) return;
+
+		int ts = m_SimulationInfo.GetTimestep();
+
+		LOGF_DEBUG(Scheduler, L"Skipping %d quiet timesteps", count);
+
+		for (int i = 0; i < m_Processors.GetLength(); i++) {
+			(*m_Processors[i])->AdvanceQuietTimesteps(count, ts);
+		}
+
+		m_SimulationInfo.AdvanceTimestep(count);
+	}
+
 	int Scheduler::GetNumberOfActiveProcessors(ProcessorType type) {
-		int count = 0;
+		//the index holds exactly the non STOP processors of the type, no need to scan
+		return m_ShortestQueueIndex[(int)type].GetLength();
+	}
+
+	float Scheduler::GetAverageProcessorUtilization() {
+		if (m_Processors.GetLength() == 0) return 0.f;
 
+		float totalUtil = 0.f;
 		for (int i = 0; i < m_Processors.GetLength(); i++) {
-			Processor* cur = *m_Processors[i];
-			if ((type == ProcessorType::None || cur->GetProcessorType() == type) && cur->GetState() != ProcessorState::STOP) {
-				count++;
-			}
+			totalUtil += (*m_Processors[i])->GetProcessorUtilization();
 		}
 
-		return count;
+		return totalUtil / (float)m_Processors.GetLength();
 	}
 
 	_STD wstring Scheduler::GetStatusbarText() {
@@ -292,63 +472,143 @@ namespace core {
 		return &m_SchedulerLock;
 	}
 
+	ProcessDirectory* Scheduler::GetProcessDirectory() {
+		return &m_ProcessDirectory;
+	}
+
+	EventTrace* Scheduler::GetEventTrace() {
+		return &m_EventTrace;
+	}
+
+	ChromeTrace* Scheduler::GetChromeTrace() {
+		return &m_ChromeTrace;
+	}
+
+	Logger* Scheduler::GetLogger() {
+		return &m_Logger;
+	}
+
+	RandomEngine* Scheduler::GetRandomEngine() {
+		return &m_RandomEngine;
+	}
+
+	SchedulerTimerWheel* Scheduler::GetTimers() {
+		return &m_Timers;
+	}
+
+	void Scheduler::SetOutputFile(_STD string filename) {
+		m_OutputFilename = filename;
+	}
+
+	UpdateProfiler* Scheduler::GetUpdateProfiler() {
+		return &m_UpdateProfiler;
+	}
+
+	void Scheduler::TraceEvent(TraceEventType type, Process* proc, Processor* processor, int arg0, int arg1) {
+		if (!m_EventTrace.IsOpen() && !m_ChromeTrace.IsOpen()) return;
+
+		int ts = m_SimulationInfo.GetTimestep();
+		int pid = proc != 0 ? proc->GetPID() : -1;
+		int processorID = processor != 0 ? processor->GetID() : -1;
+
+		m_EventTrace.Write(ts, type, pid, processorID, arg0, arg1);
+		m_ChromeTrace.Write(ts, type, pid, processorID, arg0, arg1);
+	}
+
 	void Scheduler::Update() {
 		//check for processor count, obv dont run if there are no processors
 		if (m_Processors.GetLength() == 0) {
 			PUSHCOL(COL(DARK_RED, WHITE));
-			LOG(L"No processors found !!!");
+			LOG_ERROR(Scheduler, L"No processors found !!!");
 			POPCOL();
 
 			Terminate();
 			return;
 		}
 
+		ScopedPhaseTimer updateTimer(&m_UpdateProfiler, UpdatePhase::Total);
+
 		//lock scheduler
 		m_SchedulerLock.Acquire();
 
+		//jump to the next event
+		if (m_SimulationInfo.IsEventDriven()) {
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::SkipQuiet);
+			SkipQuietTimesteps();
+		}
+
 		int ts = m_SimulationInfo.GetTimestep();
 
+		//expire the timers due by now
+		m_Timers.Advance(ts);
+
 		//set log color
 		PUSHCOL(ts % 2 == 0 ? COL(GREY, BLACK) : COL(DARK_GREY, WHITE));
 
-		LOG(L"Scheduler update started");
+		LOG_TRACE(Scheduler, L"Scheduler update started");
 
-		LOGF(L"New proc count=%d", m_NewProcesses.GetLength());
+		LOGF_TRACE(Scheduler, L"New proc count=%d", m_NewProcesses.GetLength());
 
-		//get proc at current timestep
-		Process* proc = 0;
-		while (m_NewProcesses.Peek(&proc) && proc->GetArrivalTime() == ts) {
-			//dequeue the proc
-			m_NewProcesses.Dequeue();
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::Arrivals);
 
-			LOGF(L"Dequeued proc from NEW, pid=%d", proc->GetPID());
+			//get proc at current timestep
+			Process* proc = 0;
+			while (m_NewProcesses.Peek(&proc) && proc->GetArrivalTime() == ts) {
+				//dequeue the proc
+				m_NewProcesses.Dequeue();
 
-			//schedule it
-			Schedule(proc);
+				//keep the window full
+				StreamInput();
 
-			if (m_Statistics.GetFirstProcTime() == -1) {
-				m_Statistics.SetFirstProcTime(ts);
+				LOGF_DEBUG(Scheduler, L"Dequeued proc from NEW, pid=%d", proc->GetPID());
+
+				TraceEvent(TraceEventType::Arrival, proc, 0, proc->GetCPUTime(), proc->GetDeadline());
+
+				//schedule it
+				Schedule(proc);
+
+				if (m_Statistics.GetFirstProcTime() == -1) {
+					m_Statistics.SetFirstProcTime(ts);
+				}
 			}
 		}
 
-		LOGF(L"Updating processors, count=%d", m_Processors.GetLength());
+		LOGF_TRACE(Scheduler, L"Updating processors, count=%d", m_Processors.GetLength());
 
 		//update processors
-		for (int i = 0; i < m_Processors.GetLength(); i++) {
-			Processor* processor = *m_Processors[i];
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::Processors);
+
+			for (int i = 0; i < m_Processors.GetLength(); i++) {
+				Processor* processor = *m_Processors[i];
 
-			LOGF(L"Updating processor ID=%d, type=%s", i + 1, ProcessorTypeToWString(processor->GetProcessorType()).c_str());
+				LOGF_TRACE(Processor, L"Updating processor ID=%d, type=%s", i + 1, ProcessorTypeToWString(processor->GetProcessorType()).c_str());
+
+				ScopedProcessorTimer processorTimer(&m_UpdateProfiler, processor->GetProcessorType());
+				UpdateProcessor(processor);
+			}
+		}
 
-			UpdateProcessor(processor);
+		//kill sigkill victims
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::Sigkills);
+			UpdateSigkills();
 		}
 
 		//update io
-		UpdateIO();
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::IO);
+			UpdateIO();
+		}
 
 		//work stealing
-		UpdateWorkStealing();
+		{
+			ScopedPhaseTimer timer(&m_UpdateProfiler, UpdatePhase::WorkStealing);
+			UpdateWorkStealing();
+		}
 
-		LOG(L"Scheduler update finished, notifying observers..");
+		LOG_TRACE(Scheduler, L"Scheduler update finished, notifying observers..");
 
 		//mark updated
 		m_SimulationInfo.NotifyUpdated();
@@ -366,7 +626,7 @@ namespace core {
 	}
 
 	void Scheduler::Schedule(Process* proc, ProcessorType processorType, Processor* exclude) {
-		LOG(L"Scheduling process, pid=" + _STD to_wstring(proc->GetPID()));
+		LOG_DEBUG(Scheduler, L"Scheduling process, pid=" + _STD to_wstring(proc->GetPID()));
 
 		//get processor with shortest queue
 		Processor* processor = GetProcessorWithShortestQueue(processorType, exclude);
@@ -384,67 +644,82 @@ namespace core {
 	void Scheduler::IncrementTimestep() {
 		//we can only advance timestep in interactive mode
 		if (m_SimulationInfo.GetMode() == SimulationMode::Interactive && m_SimulationInfo.GetState() == SimulationState::Playing) {
-			LOG(L"Incrementing timestep...");
+			LOG_TRACE(Scheduler, L"Incrementing timestep...");
 
 			m_SimulationInfo.IncrementTimestep();
 		}
 	}
 
-	void Scheduler::LoadSerializedData(_STD wstring& filename) {
-		LOGF(L"Loading serialized data, filename=%s", filename.c_str());
+	void Scheduler::LoadSerializedData(_STD wstring& filename, const DeserializerData* overrides) {
+		LOGF_INFO(Scheduler, L"Loading serialized data, filename=%s", filename.c_str());
+
+		//drop the previous file
+		if (m_Deserializer != 0) {
+			delete m_Deserializer;
+		}
 
-		//read input file
-		Deserializer deserializer(filename);
+		//read input file, deserializer stays alive to stream processes and sigkills
+		m_Deserializer = new Deserializer(filename, m_LoadThreads);
 
 		DeserializerData data;
 		bool success;
-		if (success = deserializer.Deserialize(data)) {
-			LOG(L"Loading success, initializing data...");
+		if (success = m_Deserializer->Deserialize(data)) {
+			LOG_INFO(Scheduler, L"Loading success, initializing data...");
+			LOGF_INFO(Scheduler, L"Random seed=%llu", (unsigned long long)m_RandomEngine.GetSeed());
 
-			//successfully deserialized data
-			for (int i = 0; i < data.proc_count; i++) {
-				m_NewProcesses.Enqueue(data.procs[i]);
+			if (overrides != 0) {
+				ApplyParameterOverrides(data, overrides);
 			}
 
-			LOGF(L"Created %d processes", data.proc_count);
+			m_LastForkedPID = data.proc_count;
 
 			//reserve memory
-			m_Processors.Reserve(data.num_processors_fcfs + data.num_processors_sjf + data.num_processors_rr);
+			int processorCount = data.num_processors_fcfs + data.num_processors_sjf + data.num_processors_rr + data.num_processors_edf;
+			m_Processors.Reserve(processorCount);
+
+			for (int i = 0; i < (int)ProcessorType::MAX; i++) {
+				m_ShortestQueueIndex[i].Reserve(processorCount);
+			}
+
+			m_LongestQueueIndex.Reserve(processorCount);
 
 			//create processors
 			for (int i = 0; i < data.num_processors_fcfs; i++) {
-				m_Processors.Add(new ProcessorFCFS(this));
+				AddProcessor(new ProcessorFCFS(this));
 			}
 
-			LOGF(L"Created %d FCFS", data.num_processors_fcfs);
+			LOGF_INFO(Scheduler, L"Created %d FCFS", data.num_processors_fcfs);
 
 			for (int i = 0; i < data.num_processors_sjf; i++) {
-				m_Processors.Add(new ProcessorSJF(this));
+				AddProcessor(new ProcessorSJF(this));
 			}
 
-			LOGF(L"Created %d SJF", data.num_processors_sjf);
+			LOGF_INFO(Scheduler, L"Created %d SJF", data.num_processors_sjf);
 
 			for (int i = 0; i < data.num_processors_rr; i++) {
-				m_Processors.Add(new ProcessorRR(this));
+				AddProcessor(new ProcessorRR(this));
 			}
 
-			LOGF(L"Created %d RR", data.num_processors_rr);
+			LOGF_INFO(Scheduler, L"Created %d RR", data.num_processors_rr);
 
 			for (int i = 0; i < data.num_processors_edf; i++) {
-				m_Processors.Add(new ProcessorEDF(this));
+				AddProcessor(new ProcessorEDF(this));
 			}
 
-			LOGF(L"Created %d EDF", data.num_processors_edf);
+			LOGF_INFO(Scheduler, L"Created %d EDF", data.num_processors_edf);
+
+			//fill the NEW and sigkill windows, the rest is read as the simulation reaches it
+			StreamInput();
 
-			//enqueue sigkills
-			for (int i = 0; i < deserializer.GetSigkillCount(); i++) {
-				ProcessorFCFS::RegisterSigkillInfo(data.sigkills[i]);
+			//first STL timestep, timestep 0 is one, a non positive stl disables stealing
+			if (data.stl > 0) {
+				m_Timers.Schedule(&m_StealTimer, 0);
 			}
 
-			LOGF(L"Created %d SIGKILLS", deserializer.GetSigkillCount());
+			LOGF_INFO(Scheduler, L"Streaming %d processes", data.proc_count);
 		}
 		else {
-			LOG(L"Loading file failed");
+			LOG_ERROR(Scheduler, L"Loading file failed, " + m_Deserializer->GetError());
 		}
 		
 		//update file load info
@@ -452,13 +727,24 @@ namespace core {
 			filename,
 			success,
 
-			//copy of deserialized data, DeserializerData::procs and DeserializerData::sigkills are invalid in this context
-			data
+			//copy of deserialized data
+			data,
+
+			m_Deserializer->GetError()
 		};
+
+		if (!success) {
+			delete m_Deserializer;
+			m_Deserializer = 0;
+		}
 	}
 
-	void Scheduler::NotifyProcessTerminated(Process* proc) {
-		LOGF(L"Terminated process notif, pid=%d", proc->GetPID());
+	void Scheduler::SetLoadThreads(int threads) {
+		m_LoadThreads = threads > 1 ? threads : 1;
+	}
+
+	void Scheduler::NotifyProcessTerminated(Process* proc, ProcessorType processorType) {
+		LOGF_DEBUG(Scheduler, L"Terminated process notif, pid=%d", proc->GetPID());
 
 		//add process to TRM list
 		m_TerminatedProcesses.Add(proc->GetPID());
@@ -467,7 +753,10 @@ namespace core {
 		proc->SetTerminationTime(m_SimulationInfo.GetTimestep());
 
 		//add stat
-		m_Statistics.AddProcessStatistic(proc);
+		m_Statistics.AddProcessStatistic(proc, processorType);
+
+		//process is gone
+		m_ProcessDirectory.Unregister(proc);
 
 		ForkingData* forkingData = proc->GetForkingData();
 
@@ -486,7 +775,7 @@ namespace core {
 			ProcessorFCFS* fcfs = dynamic_cast<ProcessorFCFS*>(child->GetOwner());
 			if (fcfs == 0) {
 				PUSHCOL(COL(RED, WHITE));
-				LOGF(L"Fatal error, forked proc owner isnt fcfs, pid=%d", child->GetPID());
+				LOGF_ERROR(Fork, L"Fatal error, forked proc owner isnt fcfs, pid=%d", child->GetPID());
 				POPCOL();
 
 				return;
@@ -496,15 +785,15 @@ namespace core {
 			child->SetState(ProcessState::ORPH);
 
 			//kill child
-			fcfs->KillProcess(child->GetPID());
+			fcfs->KillProcess(child);
 		});
 
-		//delete process
-		delete proc;
+		//free the slot
+		m_ProcessPool.Destroy(proc);
 	}
 
 	void Scheduler::NotifyProcessBlocked(Process* proc) {
-		LOGF(L"Blocked process notif, pid=%d", proc->GetPID());
+		LOGF_DEBUG(IO, L"Blocked process notif, pid=%d", proc->GetPID());
 
 		//enqueue to BLK
 		m_BlockedProcesses.Enqueue(proc);
@@ -513,16 +802,26 @@ namespace core {
 	void Scheduler::ForkProcess(Process* parent) {
 		if (parent == 0 || !parent->CanFork()) return; //parent must not be null for a forked process
 
-		LOGF(L"Forking new process, parent pid=%d", parent->GetPID());
+		LOGF_DEBUG(Fork, L"Forking new process, parent pid=%d", parent->GetPID());
+
+		//one more process to terminate
+		m_LoadFileInfo.data.proc_count++;
+
+		//skip pids of live processes the file numbered above its process count
+		int pid;
+		do {
+			pid = ++m_LastForkedPID;
+		} while (m_ProcessDirectory.GetEntry(pid) != 0);
 
 		//create new process
-		Process* child = new Process(++m_LoadFileInfo.data.proc_count,
+		Process* child = m_ProcessPool.Create(pid,
 			m_SimulationInfo.GetTimestep(),
 			parent->GetRemainingTime(),
-			0,
 			0);
 
-		LOGF(L"Child proc pid=%d", child->GetPID());
+		LOGF_DEBUG(Fork, L"Child proc pid=%d", child->GetPID());
+
+		m_ProcessDirectory.Register(child);
 
 		//assign child and parent info
 		ForkingData* parentForkingData = parent->GetForkingData();
@@ -539,12 +838,14 @@ namespace core {
 				numForked++;
 			});
 
-			LOGF(L"Number of forked children=%d", numForked);
+			LOGF_DEBUG(Fork, L"Number of forked children=%d", numForked);
 		}
 
 		//schedule child process
 		Schedule(child, ProcessorType::FCFS);
 
+		TraceEvent(TraceEventType::Fork, child, child->GetOwner(), parent->GetPID());
+
 		//increment statistic
 		m_Statistics.AddStatistic(StatisticType::Fork);
 	}
@@ -554,12 +855,17 @@ namespace core {
 		if (proc == 0) return;
 
 		PUSHCOL(COL(DARK_RED, WHITE));
-		LOGF(L"Migrating proc %d to %s", proc->GetPID(), ProcessorTypeToWString(targetProcessorType).c_str());
+		LOGF_DEBUG(Processor, L"Migrating proc %d to %s", proc->GetPID(), ProcessorTypeToWString(targetProcessorType).c_str());
 		POPCOL();
 
+		Processor* source = proc->GetOwner();
+
 		//schedule to some other processor
 		Schedule(proc, targetProcessorType);
 
+		Processor* target = proc->GetOwner();
+		TraceEvent(TraceEventType::Migration, proc, source, target != 0 ? target->GetID() : -1, (int)targetProcessorType);
+
 		//increment statistic
 
 		ProcessDynamicMetadata* metadata = proc->GetDynamicMetadata();
@@ -580,7 +886,7 @@ namespace core {
 			default:
 				//unknown migration?
 				PUSHCOL(COL(DARK_RED, WHITE));
-				LOGF(L"UNKNOWN MIGRATION, type=%s", ProcessorTypeToWString(targetProcessorType).c_str());
+				LOGF_ERROR(Processor, L"UNKNOWN MIGRATION, type=%s", ProcessorTypeToWString(targetProcessorType).c_str());
 				POPCOL();
 
 				//mark unmigrated
@@ -658,7 +964,7 @@ namespace core {
 		//IO
 		stream << L"\n\n\n\nIO mutex: ";
 		if (m_IOMutex.owner != 0) {
-			stream << L"owner(" << m_IOMutex.owner->GetPID() << L") dur(" << m_IOMutex.io_data.duration << L")";
+			stream << L"owner(" << m_IOMutex.owner->GetPID() << L") dur(" << (m_Timers.GetDeadline(&m_IOTimer) - m_SimulationInfo.GetTimestep()) << L")";
 		}
 	}
 }
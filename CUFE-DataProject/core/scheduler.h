@@ -1,18 +1,30 @@
 #pragma once
 
 #include "../common.h"
+#ifndef HEADLESS
 #include "../ui/gui.h"
+#endif
 #include "../collections/linked_list.h"
 #include "../collections/array_list.h"
 #include "../collections/linked_queue.h"
+#include "../collections/array_deque.h"
+#include "../collections/indexed_heap.h"
 #include "../utils/lock.h"
 #include "processor.h"
 #include "process.h"
+#include "process_directory.h"
 #include "simulation_info.h"
+#ifndef HEADLESS
 #include "scheduler_view.h"
+#endif
 #include "deserializer.h"
 #include "logger.h"
 #include "statistics.h"
+#include "event_trace.h"
+#include "chrome_trace.h"
+#include "update_profiler.h"
+#include "random_engine.h"
+#include "scheduler_timer.h"
 
 #include <string>
 
@@ -35,6 +47,11 @@ namespace core {
 		
 		//deserialized data
 		DeserializerData data;
+
+		/// <summary>
+		/// Parse error with its line and column, empty if loaded successfully
+		/// </summary>
+		_STD wstring error;
 	};
 
 	struct IOMutex {
@@ -44,20 +61,32 @@ namespace core {
 
 	class Scheduler {
 	private:
+#ifndef HEADLESS
 		/// <summary>
 		/// The user interface controller
 		/// </summary>
 		_UI GUI m_UI;
+#endif
 
 		/// <summary>
 		/// List of available processors
 		/// </summary>
 		_COLLECTION ArrayList<Processor*> m_Processors;
 
+		/// <summary>
+		/// Non STOP processors indexed by their queue length, per type (ProcessorType::None holds all of them)
+		/// </summary>
+		_COLLECTION IndexedHeap<_STD less<int>> m_ShortestQueueIndex[(int)ProcessorType::MAX];
+
+		/// <summary>
+		/// Non STOP processors indexed by their queue length, longest first (work stealing)
+		/// </summary>
+		_COLLECTION IndexedHeap<_STD greater<int>> m_LongestQueueIndex;
+
 		/// <summary>
 		/// Queue of NEW processes
 		/// </summary>
-		_COLLECTION LinkedQueue<Process*> m_NewProcesses;
+		_COLLECTION ArrayDeque<Process*> m_NewProcesses;
 
 		/// <summary>
 		/// List of TRM process pids
@@ -67,22 +96,54 @@ namespace core {
 		/// <summary>
 		/// Queue of BLK processes
 		/// </summary>
-		_COLLECTION ProcessLinkedQueue m_BlockedProcesses;
+		_COLLECTION ProcessArrayDeque m_BlockedProcesses;
+
+		/// <summary>
+		/// Directory of live processes, keyed by pid
+		/// </summary>
+		ProcessDirectory m_ProcessDirectory;
+
+		/// <summary>
+		/// Pid of the last forked process, forked pids continue after the loaded process count
+		/// </summary>
+		int m_LastForkedPID;
+
+		/// <summary>
+		/// Storage of every process of the simulation, released in bulk with the scheduler
+		/// </summary>
+		ProcessPool m_ProcessPool;
+
+		/// <summary>
+		/// Queue of sigkills, ordered by time
+		/// </summary>
+		_COLLECTION ArrayDeque<SigkillTimeInfo> m_Sigkills;
 
 		/// <summary>
 		/// Currently loaded file info
 		/// </summary>
 		LoadFileInfo m_LoadFileInfo;
 
+		/// <summary>
+		/// Deserializer of the loaded file, streams in processes and sigkills
+		/// </summary>
+		Deserializer* m_Deserializer;
+
+		/// <summary>
+		/// Number of threads parsing an input file, 1 streams it sequentially
+		/// </summary>
+		int m_LoadThreads;
+
 		/// <summary>
 		/// Simulation related info
 		/// </summary>
 		SimulationInfo m_SimulationInfo;
 
+#ifndef HEADLESS
 		/// <summary>
 		/// View responsible for rendering the interface
 		/// </summary>
 		SchedulerView m_View;
+#endif
 
 		/// <summary>
 		/// An IO mutex for processes to access IO
@@ -90,13 +151,53 @@ namespace core {
 		IOMutex m_IOMutex;
 
 		/// <summary>
-		/// A general purpose logger, singleton lifetime is tied to Scheduler
+		/// Deadlines of RR slices, IO completion, overheat cooldowns and work stealing, advanced to the current timestep every update
+		/// </summary>
+		SchedulerTimerWheel m_Timers;
+
+		/// <summary>
+		/// Expires when the IO of the mutex owner completes
+		/// </summary>
+		SchedulerTimer m_IOTimer;
+
+		/// <summary>
+		/// Expires on the next STL timestep
+		/// </summary>
+		SchedulerTimer m_StealTimer;
+
+		/// <summary>
+		/// A general purpose logger, bound to the thread that creates the scheduler
 		/// </summary>
 		Logger m_Logger;
 
+		/// <summary>
+		/// Hands out the random streams of the processors
+		/// </summary>
+		RandomEngine m_RandomEngine;
+
 		// Scheduler statistics
 		Statistics m_Statistics;
 
+		/// <summary>
+		/// Binary trace of scheduler activity, closed unless requested
+		/// </summary>
+		EventTrace m_EventTrace;
+
+		/// <summary>
+		/// Timeline of the simulated schedule in Chrome Trace Event JSON, closed unless requested
+		/// </summary>
+		ChromeTrace m_ChromeTrace;
+
+		/// <summary>
+		/// Wall clock time of the phases of Update, disabled unless requested
+		/// </summary>
+		UpdateProfiler m_UpdateProfiler;
+
+		/// <summary>
+		/// File the statistics are written to at termination, empty writes nothing
+		/// </summary>
+		_STD string m_OutputFilename;
+
 		// Sched lock
 		_UTIL Lock m_SchedulerLock;
 
@@ -110,6 +211,12 @@ namespace core {
 		/// </summary>
 		void UpdateIO();
 
+		/// Kills the victims of the sigkills due at the current timestep
+		void UpdateSigkills();
+
+		/// Tops up the NEW and sigkill queues from the input file, up to STREAM_LOOKAHEAD each
+		void StreamInput();
+
 		/// <summary>
 		/// Updates a processor
 		/// </summary>
@@ -118,9 +225,18 @@ namespace core {
 		/// Terminates the scheduler
 		void Terminate();
 
+		/// Adds a processor to the processor list and the queue indices
+		void AddProcessor(Processor* processor);
+
 		/// Checks for work stealing, and balances the load
 		void UpdateWorkStealing();
 
+		/// Number of upcoming timesteps in which no event occurs
+		int GetQuietTimesteps();
+
+		/// Jumps straight to the next timestep with an event, advancing everything in bulk (event driven mode)
+		void SkipQuietTimesteps();
+
 	public:
 		Scheduler();
 		~Scheduler();
@@ -139,6 +255,41 @@ namespace core {
 		// The lock owned by the scheduler
 		_UTIL Lock* GetSchedulerLock();
 
+		// Directory of live processes
+		ProcessDirectory* GetProcessDirectory();
+
+		// Binary trace of scheduler activity
+		EventTrace* GetEventTrace();
+
+		// Timeline of the simulated schedule in Chrome Trace Event JSON
+		ChromeTrace* GetChromeTrace();
+
+		// Wall clock time of the phases of Update
+		UpdateProfiler* GetUpdateProfiler();
+
+		// The logger owned by the scheduler
+		Logger* GetLogger();
+
+		/// <summary>
+		/// Hands out the random streams of the processors, seed it before loading a file for a reproducible run
+		/// </summary>
+		RandomEngine* GetRandomEngine();
+
+		/// <summary>
+		/// Timer wheel of the simulation, deadlines are timesteps
+		/// </summary>
+		SchedulerTimerWheel* GetTimers();
+
+		/// <summary>
+		/// Sets the file the statistics are written to at termination (output.txt by default), empty writes nothing
+		/// </summary>
+		void SetOutputFile(_STD string filename);
+
+		/// <summary>
+		/// Records an event in the event trace and the chrome trace at the current timestep, ignored if both are closed
+		/// </summary>
+		void TraceEvent(TraceEventType type, Process* proc, Processor* processor, int arg0 = 0, int arg1 = 0);
+
 		/// <summary>
 		/// Updates to the next frame
 		/// </summary>
@@ -156,14 +307,18 @@ namespace core {
 
 		/// <summary>
 		/// Loads the processes and other info using the deserializer
+		/// <para>Non negative fields of overrides replace the simulation parameters of the file, proc_count is ignored</para>
 		/// </summary>
-		void LoadSerializedData(_STD wstring& filename);
+		void LoadSerializedData(_STD wstring& filename, const DeserializerData* overrides = 0);
+
+		/// Sets the number of threads parsing the next loaded file
+		void SetLoadThreads(int threads);
 
 		/// <summary>
 		/// Notifies the scheduler that a process has been terminated 
-		/// and should be moved the TRM list
+		/// and should be moved the TRM list, processorType is the type of the terminating processor
 		/// </summary>
-		void NotifyProcessTerminated(Process* proc);
+		void NotifyProcessTerminated(Process* proc, ProcessorType processorType = ProcessorType::None);
 
 		/// <summary>
 		/// Notifies the scheduler that a process has been blocked 
@@ -174,6 +329,11 @@ namespace core {
 		/// Forks a new process
 		void ForkProcess(Process* parent);
 
+		/// <summary>
+		/// Notifies the scheduler that a processor's queue length or state has changed
+		/// </summary>
+		void NotifyProcessorQueueChanged(Processor* processor);
+
 		/// Migrates a process to another processor
 		void MigrateProcess(Process* proc, ProcessorType targetProcessorType);
 
@@ -183,6 +343,9 @@ namespace core {
 		/// Returns the number of non suspended processors of the specified type
 		int GetNumberOfActiveProcessors(ProcessorType type);
 
+		/// Average utilization of all processors, between 0 and 1
+		float GetAverageProcessorUtilization();
+
 		/// Toolbar summary text
 		_STD wstring GetStatusbarText();
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../common.h"
+#include "../collections/timer_wheel.h"
+
+namespace core {
+	/// <summary>
+	/// A deadline registered in the timer wheel of the scheduler
+	/// <para>Owners poll their own timers with SchedulerTimerWheel::IsExpired, nothing is dispatched</para>
+	/// </summary>
+	struct SchedulerTimer {
+		_COLLECTION TimerWheelHook<SchedulerTimer> hook;
+
+		SchedulerTimer() : hook() {
+		}
+	};
+
+	// Hook of the timer wheel holding a timer
+	struct SchedulerTimerHook {
+		_COLLECTION TimerWheelHook<SchedulerTimer>* operator()(SchedulerTimer* timer) {
+			return &timer->hook;
+		}
+	};
+
+	typedef _COLLECTION TimerWheel<SchedulerTimer, SchedulerTimerHook> SchedulerTimerWheel;
+}
@@ -1,6 +1,9 @@
 ﻿#include "scheduler_view.h"
 #include "scheduler.h"
 
+//the console UI isnt part of headless builds
+#ifndef HEADLESS
+
 #define TOOLBAR_HEIGHT 4
 
 namespace core {
@@ -147,6 +150,9 @@ namespace core {
 
 		if (m_UI->DrawButton(x, 0, logsWidth, 2, L"LOGS", COLS(COL_BG(BLACK), COL_FG(CYAN)))) {
 			m_ShowingLogs = !m_ShowingLogs;
+
+			//nobody reads the lower levels while the view is hidden, keep warnings and errors only
+			m_Scheduler->GetLogger()->SetLevel(m_ShowingLogs ? (LogLevel)LOG_COMPILE_LEVEL : LogLevel::Warning);
 		}
 
 		//render input file info
@@ -352,33 +358,25 @@ namespace core {
 	}
 
 	void SchedulerView::RenderLogs() {
-		Logger* logger = Logger::GetInstance();
-		_UTIL Lock* lock = logger->GetLoggerLock();
+		Logger* logger = m_Scheduler->GetLogger();
 
-		//acquire lock
-		lock->Acquire();
+		//copy of the latest logs, the scheduler keeps logging meanwhile
+		LogMessage logs[LOG_MAX_MESSAGES];
+		int h = logger->GetLogs(logs, LOG_MAX_MESSAGES);
 
 		_UTIL Vector2 screenSize = m_UI->GetRenderer()->GetScreenSize();
 
 		int x = VEC_INT_X(screenSize) - LOG_WIDTH;
-
-		_COLLECTION LinkedList<LogMessage>* logs = logger->GetLogs();
-
-		int h = logs->GetLength();
 		int y = VEC_INT_Y(screenSize) - h - 1;
 
 		//bg
 		m_UI->DrawBoxFilled(x, y, LOG_WIDTH, h, COL_BG(BLACK));
 
-		//manual traversal (performance)
-		for (_COLLECTION LinkedListNode<LogMessage>* node = logs->GetHead(); node; node = node->next) {
+		for (int i = 0; i < h; i++) {
 			int curY = y++;
-			m_UI->DrawLine(x, curY, x + LOG_WIDTH, curY, node->value.color, L' ');
-			m_UI->DrawString(x, curY, node->value.text, node->value.color);
+			m_UI->DrawLine(x, curY, x + LOG_WIDTH, curY, logs[i].color, L' ');
+			m_UI->DrawString(x, curY, logs[i].text, logs[i].color);
 		}
-
-		//release lock
-		lock->Release();
 	}
 
 	void SchedulerView::HandleToolbarAction(int i, _UI Color col) {
@@ -430,3 +428,5 @@ namespace core {
 		m_ToolbarColor = COL_BG(DARK_RED);
 	}
 }
+
+#endif
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include "simulation_info.h"
 
+#include <thread>
+#include <chrono>
+
+#ifndef HEADLESS
 #pragma comment(lib, "Winmm.lib")
 
 #include <Windows.h>
+#endif
 
 namespace core {
-	SimulationInfo::SimulationInfo() : m_Mode(SimulationMode::Interactive), m_State(SimulationState::Stopped), m_Timestep(0), m_Dirty(false) {
+	SimulationInfo::SimulationInfo() : m_Mode(SimulationMode::Interactive), m_State(SimulationState::Stopped), m_Timestep(0), m_Dirty(false), m_EventDriven(false) {
 		//we are initially in interactive mode and are stopped
 	}
 
@@ -30,7 +35,7 @@ namespace core {
 			return m_Dirty;
 
 		case core::SimulationMode::StepByStep: //keep the 10ms
-			Sleep(1000); //sleep for 1s
+			_STD this_thread::sleep_for(_STD chrono::seconds(1)); //sleep for 1s
 			IncrementTimestep();
 			return true;
 
@@ -51,8 +56,10 @@ namespace core {
 		m_State = SimulationState::Playing;
 		m_Dirty = true;
 
+#ifndef HEADLESS
 		//ANKARA MESSI
 		PlaySoundA("sounds\\messi.wav", 0, SND_FILENAME | SND_ASYNC);
+#endif
 
 		return true;
 	}
@@ -85,6 +92,10 @@ namespace core {
 		m_Dirty = true;
 	}
 
+	void SimulationInfo::AdvanceTimestep(int count) {
+		m_Timestep += count;
+	}
+
 	void SimulationInfo::SetMode(SimulationMode mode) {
 		//stop then change the mode
 		//Stop();
@@ -96,6 +107,14 @@ namespace core {
 		m_Dirty = false;
 	}
 
+	bool SimulationInfo::IsEventDriven() {
+		return m_EventDriven;
+	}
+
+	void SimulationInfo::SetEventDriven(bool eventDriven) {
+		m_EventDriven = eventDriven;
+	}
+
 	_STD wstring SimulationModeToWString(SimulationMode mode) {
 		switch (mode)
 		{
@@ -44,6 +44,9 @@ namespace core {
 		/// </summary>
 		bool m_Dirty;
 
+		/// Should the scheduler skip timesteps where no event occurs?
+		bool m_EventDriven;
+
 	public:
 		SimulationInfo();
 
@@ -90,6 +93,9 @@ namespace core {
 		/// </summary>
 		void IncrementTimestep();
 
+		/// Jumps the timestep forward by count
+		void AdvanceTimestep(int count);
+
 		/// <summary>
 		/// Sets the current simulaiton mode
 		/// </summary>
@@ -99,5 +105,11 @@ namespace core {
 		/// Sets the dirty flag to false (the current frame has finished running)
 		/// </summary>
 		void NotifyUpdated();
+
+		/// Is the discrete event mode enabled?
+		bool IsEventDriven();
+
+		/// Enables or disables the discrete event mode
+		void SetEventDriven(bool eventDriven);
 	};
 }
\ No newline at end of file
@@ -1,56 +1,42 @@
 #include "statistics.h"
 #include "deserializer.h"
 #include "scheduler.h"
+#include "../utils/output_file.h"
 
 #include <fstream>
 
 namespace core {
 	Statistics::Statistics(Scheduler* scheduler) : m_Scheduler(scheduler), m_FirstProcTime(-1), m_LastTime(0) {
 		memset(m_Records, 0, sizeof(int) * (int)StatisticType::MAX);
+		memset(m_ColumnTotals, 0, sizeof(long long) * (int)StatisticColumn::MAX);
 	}
 
-	int Statistics::GetAverageWaitingTime() {
-		int totalWt = 0;
+	int Statistics::GetColumnAverage(StatisticColumn column) {
+		int count = GetProcessCount();
+		if (count == 0) return 0;
 
-		for (int i = 0; i < m_Processes.GetLength(); i++) {
-			totalWt += m_Processes[i]->waiting_time;
-		}
+		return (int)(m_ColumnTotals[(int)column] / count);
+	}
 
-		return totalWt / m_Processes.GetLength();
+	int Statistics::GetAverageWaitingTime() {
+		return GetColumnAverage(StatisticColumn::WaitingTime);
 	}
 
 	int Statistics::GetAverageResponseTime() {
-		int totalRt = 0;
-
-		for (int i = 0; i < m_Processes.GetLength(); i++) {
-			totalRt += m_Processes[i]->response_time;
-		}
-
-		return totalRt / m_Processes.GetLength();
+		return GetColumnAverage(StatisticColumn::ResponseTime);
 	}
 
 	int Statistics::GetAverageTurnaroundDuration() {
-		int totalTrt = 0;
-
-		for (int i = 0; i < m_Processes.GetLength(); i++) {
-			totalTrt += m_Processes[i]->turnaround_duration;
-		}
-
-		return totalTrt / m_Processes.GetLength();
+		return GetColumnAverage(StatisticColumn::TurnaroundDuration);
 	}
 
 	int Statistics::GetAverageDeadline() {
-		int totalDl = 0;
-
-		for (int i = 0; i < m_Processes.GetLength(); i++) {
-			totalDl += m_Processes[i]->deadline;
-		}
-
-		return totalDl / m_Processes.GetLength();
+		return GetColumnAverage(StatisticColumn::Deadline);
 	}
 
-	void Statistics::AddProcessStatistic(Process* proc) {
-		m_Processes.Add(ProcessStatEntry{
+	void Statistics::AddProcessStatistic(Process* proc, ProcessorType processorType) {
+		//same order as StatisticColumn
+		int row[(int)StatisticColumn::MAX] = {
 			proc->GetTerminationTime(),
 			proc->GetPID(),
 			proc->GetArrivalTime(),
@@ -60,7 +46,152 @@ namespace core {
 			proc->GetResponseTime(),
 			proc->GetTurnaroundDuration(),
 			proc->GetDeadline()
-		});
+		};
+
+		for (int i = 0; i < (int)StatisticColumn::MAX; i++) {
+			m_Columns[i].Add(row[i]);
+			m_ColumnTotals[i] += row[i];
+		}
+
+		//latency histograms
+		ProcessOutcome outcome = proc->GetDynamicMetadata()->killed ? ProcessOutcome::Killed :
+			proc->IsForked() ? ProcessOutcome::Forked : ProcessOutcome::Normal;
+
+		//same order as LatencyMetric
+		int latencies[(int)LatencyMetric::MAX] = {
+			row[(int)StatisticColumn::WaitingTime],
+			row[(int)StatisticColumn::ResponseTime],
+			row[(int)StatisticColumn::TurnaroundDuration]
+		};
+
+		for (int i = 0; i < (int)LatencyMetric::MAX; i++) {
+			m_LatencyByProcessorType[(int)ProcessorType::None][i].Record(latencies[i]);
+			m_LatencyByOutcome[(int)outcome][i].Record(latencies[i]);
+
+			if (processorType != ProcessorType::None) {
+				m_LatencyByProcessorType[(int)processorType][i].Record(latencies[i]);
+			}
+		}
+	}
+
+	_COLLECTION LatencyHistogram* Statistics::GetLatencyHistogram(LatencyMetric metric, ProcessorType processorType) {
+		return &m_LatencyByProcessorType[(int)processorType][(int)metric];
+	}
+
+	_COLLECTION LatencyHistogram* Statistics::GetLatencyHistogram(LatencyMetric metric, ProcessOutcome outcome) {
+		return &m_LatencyByOutcome[(int)outcome][(int)metric];
+	}
+
+	void Statistics::MergeLatencyHistograms(Statistics* other) {
+		for (int i = 0; i < (int)LatencyMetric::MAX; i++) {
+			for (int type = 0; type < (int)ProcessorType::MAX; type++) {
+				m_LatencyByProcessorType[type][i].Merge(other->m_LatencyByProcessorType[type][i]);
+			}
+
+			for (int outcome = 0; outcome < (int)ProcessOutcome::MAX; outcome++) {
+				m_LatencyByOutcome[outcome][i].Merge(other->m_LatencyByOutcome[outcome][i]);
+			}
+		}
+	}
+
+	void Statistics::WriteLatencyPercentiles(_STD ofstream& stream, const char* name, _COLLECTION LatencyHistogram* histograms) {
+		char buf[256];
+
+		sprintf(buf, "%-8s n=%-8lld", name, histograms[0].GetTotalCount());
+		stream << buf;
+
+		const char* metricNames[(int)LatencyMetric::MAX] = { "WT", "RT", "TRT" };
+
+		for (int i = 0; i < (int)LatencyMetric::MAX; i++) {
+			_COLLECTION LatencyHistogram& histogram = histograms[i];
+
+			sprintf(buf,
+				"\t%s = %d/%d/%d/%d",
+				metricNames[i],
+				histogram.GetPercentile(50.0),
+				histogram.GetPercentile(90.0),
+				histogram.GetPercentile(99.0),
+				histogram.GetPercentile(99.9));
+			stream << buf;
+		}
+
+		stream << '\n';
+	}
+
+	void Statistics::WriteLatencySidecar(_STD string filename) {
+		//output.txt -> output_latency.json
+		_STD ofstream stream(_UTIL GetSidecarFilename(filename, "_latency.json"), _STD ios::out);
+		if (!stream.good()) return;
+
+		char buf[256];
+
+		const char* metricNames[(int)LatencyMetric::MAX] = { "wt", "rt", "trt" };
+
+		//groups in output order
+		constexpr int groupCount = (int)ProcessorType::MAX + (int)ProcessOutcome::MAX;
+
+		const char* groupNames[groupCount] = {
+			"all", "fcfs", "sjf", "rr", "edf",
+			"normal", "killed", "forked"
+		};
+
+		_COLLECTION LatencyHistogram* groups[groupCount];
+		for (int i = 0; i < (int)ProcessorType::MAX; i++) {
+			groups[i] = m_LatencyByProcessorType[i];
+		}
+
+		for (int i = 0; i < (int)ProcessOutcome::MAX; i++) {
+			groups[(int)ProcessorType::MAX + i] = m_LatencyByOutcome[i];
+		}
+
+		sprintf(buf, "{\n\t\"sub_bucket_bits\": %d,\n\t\"groups\": {\n", LATENCY_HISTOGRAM_SUB_BUCKET_BITS);
+		stream << buf;
+
+		for (int g = 0; g < groupCount; g++) {
+			sprintf(buf, "\t\t\"%s\": {\n\t\t\t\"count\": %lld", groupNames[g], groups[g][0].GetTotalCount());
+			stream << buf;
+
+			for (int i = 0; i < (int)LatencyMetric::MAX; i++) {
+				_COLLECTION LatencyHistogram& histogram = groups[g][i];
+
+				sprintf(buf,
+					",\n\t\t\t\"%s\": { \"min\": %d, \"max\": %d, \"p50\": %d, \"p90\": %d, \"p99\": %d, \"p999\": %d, \"buckets\": [",
+					metricNames[i],
+					histogram.GetMin(),
+					histogram.GetMax(),
+					histogram.GetPercentile(50.0),
+					histogram.GetPercentile(90.0),
+					histogram.GetPercentile(99.0),
+					histogram.GetPercentile(99.9));
+				stream << buf;
+
+				//non empty buckets only, as [index, count]
+				bool first = true;
+				for (int b = 0; b < LATENCY_HISTOGRAM_BUCKETS; b++) {
+					long long count = histogram.GetBucketCount(b);
+					if (count == 0) continue;
+
+					sprintf(buf, "%s[%d, %lld]", first ? "" : ", ", b, count);
+					stream << buf;
+
+					first = false;
+				}
+
+				stream << "] }";
+			}
+
+			stream << (g < groupCount - 1 ? "\n\t\t},\n" : "\n\t\t}\n");
+		}
+
+		stream << "\t}\n}\n";
+	}
+
+	int Statistics::GetProcessCount() {
+		return m_Columns[0].GetLength();
+	}
+
+	int* Statistics::GetColumn(StatisticColumn column) {
+		return m_Columns[(int)column][0];
 	}
 
 	void Statistics::AddStatistic(StatisticType type) {
@@ -69,6 +200,10 @@ namespace core {
 		}
 	}
 
+	int Statistics::GetStatistic(StatisticType type) {
+		return type != StatisticType::MAX ? m_Records[(int)type] : 0;
+	}
+
 	int Statistics::GetTotalTurnaroundDuration() {
 		return m_LastTime - m_FirstProcTime;
 	}
@@ -97,7 +232,7 @@ namespace core {
 		char buf[1024];
 		
 		//write header
-		constexpr int headerCount = 9;
+		constexpr int headerCount = (int)StatisticColumn::MAX;
 
 		const char* header[headerCount] = {
 			"TT", "PID", "AT", "CT", "IO_D", "WT", "RT", "TRT", "DL"
@@ -110,16 +245,19 @@ namespace core {
 
 		stream << '\n';
 
-		int procCount = m_Processes.GetLength();
+		int procCount = GetProcessCount();
+
+		int* columns[headerCount];
+		for (int j = 0; j < headerCount; j++) {
+			columns[j] = GetColumn((StatisticColumn)j);
+		}
 
 		//write procs
 		for (int i = 0; i < procCount; i++) {
-			ProcessStatEntry* stat = m_Processes[i];
-
 			for (int j = 0; j < headerCount; j++) {
 				sprintf(buf,
 					"%-10d", 
-					*(int*)((uintptr_t)stat + 0x4ULL * j));
+					columns[j][i]);
 				stream << buf;
 			}
 
@@ -141,6 +279,24 @@ namespace core {
 			GetAverageDeadline());
 		stream << buf;
 
+		//latency percentiles
+		stream << "Latency percentiles (p50/p90/p99/p999)\n";
+
+		const char* typeNames[(int)ProcessorType::MAX] = { "All", "FCFS", "SJF", "RR", "EDF" };
+		for (int i = 0; i < (int)ProcessorType::MAX; i++) {
+			//always write all, skip empty groups
+			if (i != (int)ProcessorType::None && m_LatencyByProcessorType[i][0].GetTotalCount() == 0) continue;
+
+			WriteLatencyPercentiles(stream, typeNames[i], m_LatencyByProcessorType[i]);
+		}
+
+		const char* outcomeNames[(int)ProcessOutcome::MAX] = { "Normal", "Killed", "Forked" };
+		for (int i = 0; i < (int)ProcessOutcome::MAX; i++) {
+			if (m_LatencyByOutcome[i][0].GetTotalCount() == 0) continue;
+
+			WriteLatencyPercentiles(stream, outcomeNames[i], m_LatencyByOutcome[i]);
+		}
+
 		//migration
 		sprintf(buf, 
 			"Migration %%:\t\tRTF = %.0f%%\t\tMaxW = %.0f%%\n",
@@ -251,5 +407,8 @@ namespace core {
 		stream << buf;
 
 		stream.close();
+
+		//full histograms for offline analysis and merging runs
+		WriteLatencySidecar(filename);
 	}
 }
\ No newline at end of file
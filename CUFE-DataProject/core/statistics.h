@@ -3,28 +3,29 @@
 #include "../common.h"
 #include "../collections/linked_queue.h"
 #include "../collections/array_list.h"
+#include "../collections/latency_histogram.h"
 #include "process.h"
 #include "processor.h"
 
 #include <string>
+#include <fstream>
 
 namespace core {
 	class Scheduler;
 	
-	struct ProcessStatEntry {
-		int termination_time;
-		int pid;
-		int arrival_time;
-		int cpu_time;
-		int total_io_time;
-		int waiting_time;
-		int response_time;
-		int turnaround_duration;
-		int deadline;
-
-		bool operator==(ProcessStatEntry& other) {
-			return memcmp(this, &other, sizeof(ProcessStatEntry)) == 0;
-		}
+	/// Per process statistic columns, in output order
+	enum class StatisticColumn {
+		TerminationTime, // TT
+		PID,
+		ArrivalTime, // AT
+		CpuTime, // CT
+		TotalIOTime, // IO_D
+		WaitingTime, // WT
+		ResponseTime, // RT
+		TurnaroundDuration, // TRT
+		Deadline, // DL
+
+		MAX
 	};
 
 	enum class StatisticType {
@@ -40,20 +41,41 @@ namespace core {
 		MAX
 	};
 
+	/// How a process left the system
+	enum class ProcessOutcome {
+		Normal,
+		Killed,
+		Forked,
+
+		MAX
+	};
+
+	/// Latencies recorded in histograms
+	enum class LatencyMetric {
+		WaitingTime, // WT
+		ResponseTime, // RT
+		TurnaroundDuration, // TRT
+
+		MAX
+	};
+
 	class Statistics {
 	private:
 		/// Pointer to scheduler
 		Scheduler* m_Scheduler;
 
-		/// Processes stat list
-		/// we are not using Queue for the following reason
-		///	we may want to calculate things like average waiting time, etc
-		///		and we would need to keep track of the length of the stats, etc
-		///		by the time we print the process stats, the queue will be empty
-		///		thus we would have needed to keep track of each property seperately
-		///		-- total waiting time, total rt, total trt, etc..
-		///		it becomes messy and it defeats the purpose of storing the stats in a struct of its own
-		_COLLECTION LinkedList<ProcessStatEntry> m_Processes;
+		/// Process stats, stored column wise (one array per StatisticColumn)
+		/// row i of every column belongs to the i-th terminated process
+		_COLLECTION ArrayList<int> m_Columns[(int)StatisticColumn::MAX];
+
+		/// Running totals of every column, so averages are O(1)
+		long long m_ColumnTotals[(int)StatisticColumn::MAX];
+
+		/// Latency histograms per processor type that terminated the process, ProcessorType::None holds all processes
+		_COLLECTION LatencyHistogram m_LatencyByProcessorType[(int)ProcessorType::MAX][(int)LatencyMetric::MAX];
+
+		/// Latency histograms per process outcome
+		_COLLECTION LatencyHistogram m_LatencyByOutcome[(int)ProcessOutcome::MAX][(int)LatencyMetric::MAX];
 
 		/// Statistic Records
 		int m_Records[(int)StatisticType::MAX];
@@ -61,6 +83,36 @@ namespace core {
 		int m_FirstProcTime;
 		int m_LastTime;
 
+		/// Returns the average of a column, 0 if there are no processes
+		int GetColumnAverage(StatisticColumn column);
+
+		/// Writes the percentiles of a latency group as a line of the output file
+		void WriteLatencyPercentiles(_STD ofstream& stream, const char* name, _COLLECTION LatencyHistogram* histograms);
+
+		/// Writes the latency histograms and their percentiles as json next to the output file
+		void WriteLatencySidecar(_STD string filename);
+
+	public:
+		Statistics(Scheduler* scheduler);
+
+		/// Adds a process statistic, processorType is the type of the processor that terminated it
+		void AddProcessStatistic(Process* proc, ProcessorType processorType = ProcessorType::None);
+
+		/// Returns a latency histogram of processes terminated by a processor type (ProcessorType::None for all processes)
+		_COLLECTION LatencyHistogram* GetLatencyHistogram(LatencyMetric metric, ProcessorType processorType = ProcessorType::None);
+
+		/// Returns a latency histogram of processes with an outcome
+		_COLLECTION LatencyHistogram* GetLatencyHistogram(LatencyMetric metric, ProcessOutcome outcome);
+
+		/// Adds the latency histograms of another run
+		void MergeLatencyHistograms(Statistics* other);
+
+		/// Incremets a statistic of certain type
+		void AddStatistic(StatisticType type);
+
+		/// Number of times a statistic of certain type was recorded
+		int GetStatistic(StatisticType type);
+
 		/// Returns the average waiting time of all processes
 		int GetAverageWaitingTime();
 
@@ -73,14 +125,11 @@ namespace core {
 		/// Returns the average deadline of all processes
 		int GetAverageDeadline();
 
-	public:
-		Statistics(Scheduler* scheduler);
-
-		/// Adds a process statistic
-		void AddProcessStatistic(Process* proc);
+		/// Number of process stats
+		int GetProcessCount();
 
-		/// Incremets a statistic of certain type
-		void AddStatistic(StatisticType type);
+		/// Contiguous values of a column, GetProcessCount() long (null if there are none)
+		int* GetColumn(StatisticColumn column);
 
 		/// Total TRT of process entries
 		int GetTotalTurnaroundDuration();
@@ -0,0 +1,97 @@
+#include "update_profiler.h"
+
+#include <fstream>
+#include <climits>
+
+namespace core {
+	UpdateProfiler::UpdateProfiler() : m_Enabled(false) {
+		Clear();
+	}
+
+	void UpdateProfiler::SetEnabled(bool enabled) {
+		m_Enabled = enabled;
+	}
+
+	void UpdateProfiler::Record(UpdatePhase phase, long long nanoseconds) {
+		//histograms hold ints, a phase longer than 2s is clamped
+		m_Phases[(int)phase].Record(nanoseconds > INT_MAX ? INT_MAX : (int)nanoseconds);
+		m_PhaseTotals[(int)phase] += nanoseconds;
+	}
+
+	void UpdateProfiler::Record(ProcessorType type, long long nanoseconds) {
+		m_ProcessorTypes[(int)type].Record(nanoseconds > INT_MAX ? INT_MAX : (int)nanoseconds);
+		m_ProcessorTypeTotals[(int)type] += nanoseconds;
+	}
+
+	_COLLECTION LatencyHistogram* UpdateProfiler::GetHistogram(UpdatePhase phase) {
+		return &m_Phases[(int)phase];
+	}
+
+	_COLLECTION LatencyHistogram* UpdateProfiler::GetHistogram(ProcessorType type) {
+		return &m_ProcessorTypes[(int)type];
+	}
+
+	void UpdateProfiler::Clear() {
+		for (int i = 0; i < (int)UpdatePhase::MAX; i++) {
+			m_Phases[i].Clear();
+			m_PhaseTotals[i] = 0;
+		}
+
+		for (int i = 0; i < (int)ProcessorType::MAX; i++) {
+			m_ProcessorTypes[i].Clear();
+			m_ProcessorTypeTotals[i] = 0;
+		}
+	}
+
+	void UpdateProfiler::WriteSummaryLine(_STD ofstream& stream, const char* name, _COLLECTION LatencyHistogram& histogram,
+		long long total, long long updateTotal) {
+		char buf[256];
+
+		long long count = histogram.GetTotalCount();
+		sprintf(buf, "%-14s %10lld %12.3f %7.2f%% %10lld %10d %10d %10d %10d\n",
+			name,
+			count,
+			total / 1000000.0,
+			updateTotal == 0 ? 0.0 : total * 100.0 / updateTotal,
+			count == 0 ? 0 : total / count,
+			histogram.GetPercentile(50.0),
+			histogram.GetPercentile(90.0),
+			histogram.GetPercentile(99.0),
+			histogram.GetMax());
+
+		stream << buf;
+	}
+
+	void UpdateProfiler::WriteToFile(_STD string filename) {
+		_STD ofstream stream(filename, _STD ios::out);
+		if (!stream.good()) return;
+
+		char buf[256];
+
+		//percentiles are in ns
+		sprintf(buf, "%-14s %10s %12s %8s %10s %10s %10s %10s %10s\n",
+			"PHASE", "COUNT", "TOTAL_MS", "SHARE", "MEAN_NS", "P50_NS", "P90_NS", "P99_NS", "MAX_NS");
+		stream << buf;
+
+		const char* phaseNames[(int)UpdatePhase::MAX] = {
+			"SkipQuiet", "Arrivals", "Processors", "Sigkills", "IO", "WorkStealing", "Statistics", "Total"
+		};
+
+		long long updateTotal = m_PhaseTotals[(int)UpdatePhase::Total];
+
+		for (int i = 0; i < (int)UpdatePhase::MAX; i++) {
+			WriteSummaryLine(stream, phaseNames[i], m_Phases[i], m_PhaseTotals[i], updateTotal);
+
+			//per processor type breakdown, time of a single processor update
+			if (i == (int)UpdatePhase::Processors) {
+				for (int type = (int)ProcessorType::None + 1; type < (int)ProcessorType::MAX; type++) {
+					//names are plain ascii
+					_STD wstring typeName = ProcessorTypeToWString((ProcessorType)type);
+					_STD string name = "  " + _STD string(typeName.begin(), typeName.end());
+
+					WriteSummaryLine(stream, name.c_str(), m_ProcessorTypes[type], m_ProcessorTypeTotals[type], updateTotal);
+				}
+			}
+		}
+	}
+}
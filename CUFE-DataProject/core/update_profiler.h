@@ -0,0 +1,156 @@
+#pragma once
+
+#include "../common.h"
+#include "../collections/latency_histogram.h"
+#include "processor.h"
+
+#include <chrono>
+#include <string>
+
+namespace core {
+	/// <summary>
+	/// Phases of Scheduler::Update
+	/// </summary>
+	enum class UpdatePhase {
+		// Jumping over quiet timesteps (event driven mode)
+		SkipQuiet,
+
+		// Draining NEW processes that arrive at the timestep
+		Arrivals,
+
+		// The UpdateProcessor loop, broken down per ProcessorType as well
+		Processors,
+
+		Sigkills,
+		IO,
+		WorkStealing,
+
+		// Writing the output file at termination
+		Statistics,
+
+		// The whole update
+		Total,
+
+		MAX
+	};
+
+	/// <summary>
+	/// Wall clock time spent in every phase of Scheduler::Update, in nanosecond histograms
+	/// <para>Disabled by default, a disabled profiler never reads the clock</para>
+	/// </summary>
+	class UpdateProfiler {
+	private:
+		/// <summary>
+		/// Is timing enabled?
+		/// </summary>
+		bool m_Enabled;
+
+		/// <summary>
+		/// Duration histograms per phase
+		/// </summary>
+		_COLLECTION LatencyHistogram m_Phases[(int)UpdatePhase::MAX];
+
+		/// <summary>
+		/// Duration histograms of a single UpdateProcessor call per processor type, ProcessorType::None is unused
+		/// </summary>
+		_COLLECTION LatencyHistogram m_ProcessorTypes[(int)ProcessorType::MAX];
+
+		/// <summary>
+		/// Total time per phase, histograms only keep the distribution
+		/// </summary>
+		long long m_PhaseTotals[(int)UpdatePhase::MAX];
+
+		/// <summary>
+		/// Total time per processor type
+		/// </summary>
+		long long m_ProcessorTypeTotals[(int)ProcessorType::MAX];
+
+		/// Writes a summary line of a histogram
+		static void WriteSummaryLine(_STD ofstream& stream, const char* name, _COLLECTION LatencyHistogram& histogram,
+			long long total, long long updateTotal);
+
+	public:
+		UpdateProfiler();
+
+		/// <summary>
+		/// Current time of the profiling clock in nanoseconds
+		/// </summary>
+		static long long Now() {
+			return _STD chrono::duration_cast<_STD chrono::nanoseconds>(_STD chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/// <summary>
+		/// Is timing enabled?
+		/// </summary>
+		bool IsEnabled() {
+			return m_Enabled;
+		}
+
+		/// <summary>
+		/// Enables or disables timing
+		/// </summary>
+		void SetEnabled(bool enabled);
+
+		/// <summary>
+		/// Records the duration of a phase
+		/// </summary>
+		void Record(UpdatePhase phase, long long nanoseconds);
+
+		/// <summary>
+		/// Records the duration of an UpdateProcessor call
+		/// </summary>
+		void Record(ProcessorType type, long long nanoseconds);
+
+		/// <summary>
+		/// Duration histogram of a phase
+		/// </summary>
+		_COLLECTION LatencyHistogram* GetHistogram(UpdatePhase phase);
+
+		/// <summary>
+		/// Duration histogram of UpdateProcessor calls of a processor type
+		/// </summary>
+		_COLLECTION LatencyHistogram* GetHistogram(ProcessorType type);
+
+		/// <summary>
+		/// Removes all recorded durations
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Writes a per phase summary, count, total, share of the update time and percentiles
+		/// </summary>
+		void WriteToFile(_STD string filename);
+	};
+
+	/// <summary>
+	/// Times its scope into a phase or processor type of an UpdateProfiler
+	/// </summary>
+	template<typename Key>
+	class ScopedUpdateTimer {
+	private:
+		UpdateProfiler* m_Profiler;
+		Key m_Key;
+
+		/// <summary>
+		/// Clock at construction, -1 if the profiler was disabled
+		/// </summary>
+		long long m_Start;
+
+	public:
+		ScopedUpdateTimer(UpdateProfiler* profiler, Key key) : m_Profiler(profiler), m_Key(key),
+			m_Start(profiler->IsEnabled() ? UpdateProfiler::Now() : -1) {
+		}
+
+		ScopedUpdateTimer(const ScopedUpdateTimer&) = delete;
+		ScopedUpdateTimer& operator=(const ScopedUpdateTimer&) = delete;
+
+		~ScopedUpdateTimer() {
+			if (m_Start != -1) {
+				m_Profiler->Record(m_Key, UpdateProfiler::Now() - m_Start);
+			}
+		}
+	};
+
+	typedef ScopedUpdateTimer<UpdatePhase> ScopedPhaseTimer;
+	typedef ScopedUpdateTimer<ProcessorType> ScopedProcessorTimer;
+}
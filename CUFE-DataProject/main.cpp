@@ -1,19 +1,243 @@
 #include <iostream>
+#include <string>
+#include <thread>
+
+#ifndef HEADLESS
 #include <Windows.h>
+#endif
 
 #include "common.h"
 #include "core/scheduler.h"
-#include "core/random_engine.h"
+#include "core/parameter_sweep.h"
+#include "core/binary_workload.h"
+#include "core/event_trace.h"
 
 using namespace core;
 
-int main() {
-	//init random engine
-	RandomEngine::Initialize();
+#ifdef HEADLESS
+/// <summary>
+/// Batch driver, loads the input file and runs the simulation to completion at full speed
+/// </summary>
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		_STD cout << "Usage: " << argv[0] << " <input file> [--load-threads <count>] [--seed <seed>] [--trace <trace file>] [--chrome-trace <json file>] [--profile]\n"
+			<< "       " << argv[0] << " --to-binary <input file> <output file>\n"
+			<< "       " << argv[0] << " --to-text <input file> <output file>\n"
+			<< "       " << argv[0] << " --decode-trace <trace file> <output file> [--csv]\n"
+			<< "       " << argv[0] << " --sweep <input file> <results file> [--threads <count>] [--seed <seed>] [--timeslice <list>] [--rtf <list>]\n"
+			<< "             [--maxw <list>] [--stl <list>] [--fork <list>] [--processors <fcfs:sjf:rr:edf list>]\n";
+		return 1;
+	}
+
+	//workload conversion
+	_STD string command = argv[1];
+	if (command == "--to-binary" || command == "--to-text") {
+		if (argc < 4) {
+			_STD cout << "Missing input or output file\n";
+			return 1;
+		}
+
+		//paths are plain ascii
+		_STD string src = argv[2], dst = argv[3];
+		_STD wstring srcFilename(src.begin(), src.end()), dstFilename(dst.begin(), dst.end());
+
+		_STD wstring error;
+		bool success = command == "--to-binary" ? ConvertToBinaryWorkload(srcFilename, dstFilename, error)
+			: ConvertToTextWorkload(srcFilename, dstFilename, error);
+
+		if (!success) {
+			_STD cout << "Failed to convert " << src << ", " << _STD string(error.begin(), error.end()) << '\n';
+			return 1;
+		}
+
+		return 0;
+	}
+
+	//event trace decoding
+	if (command == "--decode-trace") {
+		if (argc < 4) {
+			_STD cout << "Missing trace or output file\n";
+			return 1;
+		}
+
+		//paths are plain ascii
+		_STD string src = argv[2], dst = argv[3];
+		_STD wstring srcFilename(src.begin(), src.end()), dstFilename(dst.begin(), dst.end());
+
+		bool csv = argc >= 5 && _STD string(argv[4]) == "--csv";
+
+		_STD wstring error;
+		if (!DecodeEventTrace(srcFilename, dstFilename, csv, error)) {
+			_STD cout << "Failed to decode " << src << ", " << _STD string(error.begin(), error.end()) << '\n';
+			return 1;
+		}
+
+		return 0;
+	}
+
+	//parameter sweep, every combination of the listed values runs as its own scheduler
+	if (command == "--sweep") {
+		if (argc < 4) {
+			_STD cout << "Missing input or results file\n";
+			return 1;
+		}
+
+		//paths are plain ascii
+		_STD string src = argv[2], dst = argv[3];
+		_STD wstring srcFilename(src.begin(), src.end()), dstFilename(dst.begin(), dst.end());
+
+		SweepGrid grid;
+		int threads = (int)_STD thread::hardware_concurrency();
+
+		//seeded from the random device unless given
+		_STD string seed;
+
+		//option, swept parameter and smallest value
+		struct {
+			const char* option;
+			SweepParameter parameter;
+			int minValue;
+		} listOptions[] = {
+			{ "--timeslice", SweepParameter::RRTimeslice, 1 },
+			{ "--rtf", SweepParameter::RTF, 0 },
+			{ "--maxw", SweepParameter::MaxW, 0 },
+			{ "--stl", SweepParameter::STL, 1 },
+			{ "--fork", SweepParameter::ForkProb, 0 }
+		};
+
+		_STD wstring error;
+		for (int i = 4; i < argc && error.empty(); i++) {
+			_STD string option = argv[i];
+
+			if (option == "--threads" && i + 1 < argc) {
+				threads = atoi(argv[++i]);
+			}
+			else if (option == "--seed" && i + 1 < argc) {
+				seed = argv[++i];
+			}
+			else if (option == "--processors" && i + 1 < argc) {
+				ParseSweepValues(argv[++i], 4, 0, grid.processor_counts, error);
+			}
+			else {
+				for (auto& listOption : listOptions) {
+					if (option == listOption.option && i + 1 < argc) {
+						ParseSweepValues(argv[++i], 1, listOption.minValue, grid.values[(int)listOption.parameter], error);
+						break;
+					}
+				}
+			}
+		}
+
+		if (!error.empty()) {
+			_STD cout << "Invalid sweep, " << _STD string(error.begin(), error.end()) << '\n';
+			return 1;
+		}
+
+		ParameterSweep sweep(srcFilename, &grid);
+
+		//every run uses the same seed, configurations are compared on the same random events
+		if (!seed.empty()) {
+			sweep.SetSeed(strtoull(seed.c_str(), 0, 10));
+		}
+
+		if (!sweep.Run(threads, error) || !sweep.WriteResults(dstFilename, error)) {
+			_STD cout << "Sweep failed, " << _STD string(error.begin(), error.end()) << '\n';
+			return 1;
+		}
+
+		_STD cout << "Ran " << sweep.GetRunCount() << " configurations\n";
+		return 0;
+	}
+
+	int exitCode = 0;
+
+	{
+		Scheduler sched;
+
+		//no log view, drop every line before it is formatted
+		sched.GetLogger()->SetLevel(LogLevel::MAX);
+
+		//input files are plain ascii
+		_STD string path = argv[1];
+		_STD wstring filename(path.begin(), path.end());
+
+		//options follow the input file
+		_STD string tracePath, chromeTracePath;
+		for (int i = 2; i < argc; i++) {
+			_STD string option = argv[i];
+
+			if (option == "--load-threads" && i + 1 < argc) {
+				//parse large files on several threads
+				sched.SetLoadThreads(atoi(argv[++i]));
+			}
+			else if (option == "--seed" && i + 1 < argc) {
+				//reproducible run, streams are created when the file is loaded
+				sched.GetRandomEngine()->SetSeed(strtoull(argv[++i], 0, 10));
+			}
+			else if (option == "--trace" && i + 1 < argc) {
+				tracePath = argv[++i];
+			}
+			else if (option == "--chrome-trace" && i + 1 < argc) {
+				chromeTracePath = argv[++i];
+			}
+			else if (option == "--profile") {
+				//per phase timings are written next to the output file, output_profile.txt
+				sched.GetUpdateProfiler()->SetEnabled(true);
+			}
+		}
 
+		if (!tracePath.empty()) {
+			_STD wstring traceFilename(tracePath.begin(), tracePath.end()), error;
+			if (!sched.GetEventTrace()->Open(traceFilename, error)) {
+				_STD cout << "Failed to open " << tracePath << ", " << _STD string(error.begin(), error.end()) << '\n';
+				exitCode = 1;
+			}
+		}
+
+		if (!chromeTracePath.empty()) {
+			_STD wstring traceFilename(chromeTracePath.begin(), chromeTracePath.end()), error;
+			if (!sched.GetChromeTrace()->Open(traceFilename, error)) {
+				_STD cout << "Failed to open " << chromeTracePath << ", " << _STD string(error.begin(), error.end()) << '\n';
+				exitCode = 1;
+			}
+		}
+
+		if (exitCode == 0) {
+			sched.LoadSerializedData(filename);
+
+			if (!sched.GetLoadFileInfo()->success) {
+				//errors are plain ascii
+				_STD wstring& error = sched.GetLoadFileInfo()->error;
+				_STD cout << "Failed to load " << path << ", " << _STD string(error.begin(), error.end()) << '\n';
+				exitCode = 1;
+			}
+		}
+
+		if (exitCode == 0) {
+			SimulationInfo* simInfo = sched.GetSimulationInfo();
+
+			//silent mode advances the timestep on every update
+			//event driven mode jumps over timesteps where nothing happens
+			simInfo->SetMode(SimulationMode::Silent);
+			simInfo->SetEventDriven(true);
+			simInfo->Start();
+
+			//scheduler stops the simulation once all processes are TRM and output.txt is written
+			//sleep time is ignored, nobody is watching
+			int sleepTime;
+			while (simInfo->CanUpdateScheduler(&sleepTime)) {
+				sched.Update();
+			}
+		}
+	}
+
+	return exitCode;
+}
+#else
+int main() {
 	Scheduler sched;
 
-	LOG(L"Initializing...");
+	LOG_INFO(Scheduler, L"Initializing...");
 
 	while (true) {
 		int sleepTime = 10; //by default sleep for 10ms
@@ -27,8 +251,6 @@ int main() {
 		}
 	}
 
-	//clean up random engine
-	RandomEngine::Clean();
-
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
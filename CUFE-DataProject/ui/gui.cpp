@@ -1,5 +1,8 @@
 #include "gui.h"
 
+//the console UI isnt part of headless builds
+#ifndef HEADLESS
+
 #include <Windows.h>
 
 #define _USE_MATH_DEFINES
@@ -180,4 +183,5 @@ namespace ui {
 		((GUI*)param)->UIRenderLoop();
 		return 0;
 	}
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
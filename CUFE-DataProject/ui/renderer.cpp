@@ -1,5 +1,8 @@
 #include "renderer.h"
 
+//the console UI isnt part of headless builds
+#ifndef HEADLESS
+
 #include <Windows.h>
 
 namespace ui {
@@ -180,3 +183,5 @@ namespace ui {
 		}
 	}
 }
+
+#endif
\ No newline at end of file
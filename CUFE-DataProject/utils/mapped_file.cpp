@@ -0,0 +1,132 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+#ifdef _WIN32
+	MappedFile::MappedFile() : m_Data(0), m_Size(0), m_File(INVALID_HANDLE_VALUE), m_Mapping(0) {
+	}
+#else
+	MappedFile::MappedFile() : m_Data(0), m_Size(0), m_File(-1) {
+	}
+#endif
+
+	MappedFile::~MappedFile() {
+		Close();
+	}
+
+	bool MappedFile::Open(const _STD wstring& path) {
+		Close();
+
+#ifdef _WIN32
+		m_File = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+		if (m_File == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_File, &size)) {
+			Close();
+			return false;
+		}
+
+		m_Size = (size_t)size.QuadPart;
+
+		//empty files cant be mapped
+		if (m_Size == 0) return true;
+
+		m_Mapping = CreateFileMappingW(m_File, 0, PAGE_READONLY, 0, 0, 0);
+		if (m_Mapping == 0) {
+			Close();
+			return false;
+		}
+
+		m_Data = (const char*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+		if (m_Data == 0) {
+			Close();
+			return false;
+		}
+#else
+		//paths are plain ascii
+		_STD string narrowPath(path.begin(), path.end());
+
+		m_File = open(narrowPath.c_str(), O_RDONLY);
+		if (m_File == -1) return false;
+
+		struct stat st;
+		if (fstat(m_File, &st) != 0) {
+			Close();
+			return false;
+		}
+
+		m_Size = (size_t)st.st_size;
+
+		//empty files cant be mapped
+		if (m_Size == 0) return true;
+
+		void* data = mmap(0, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+		if (data == MAP_FAILED) {
+			Close();
+			return false;
+		}
+
+		//file is scanned front to back
+		madvise(data, m_Size, MADV_SEQUENTIAL);
+
+		m_Data = (const char*)data;
+#endif
+
+		return true;
+	}
+
+	void MappedFile::Close() {
+#ifdef _WIN32
+		if (m_Data != 0) {
+			UnmapViewOfFile(m_Data);
+		}
+
+		if (m_Mapping != 0) {
+			CloseHandle(m_Mapping);
+			m_Mapping = 0;
+		}
+
+		if (m_File != INVALID_HANDLE_VALUE) {
+			CloseHandle(m_File);
+			m_File = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (m_Data != 0) {
+			munmap((void*)m_Data, m_Size);
+		}
+
+		if (m_File != -1) {
+			close(m_File);
+			m_File = -1;
+		}
+#endif
+
+		m_Data = 0;
+		m_Size = 0;
+	}
+
+	bool MappedFile::IsOpen() {
+#ifdef _WIN32
+		return m_File != INVALID_HANDLE_VALUE;
+#else
+		return m_File != -1;
+#endif
+	}
+
+	const char* MappedFile::GetData() {
+		return m_Data;
+	}
+
+	size_t MappedFile::GetSize() {
+		return m_Size;
+	}
+}
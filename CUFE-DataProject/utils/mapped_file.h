@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+
+namespace utils {
+	// Read only memory mapping of a whole file
+	class MappedFile {
+	private:
+		// Start of the mapped view, null if nothing is mapped
+		const char* m_Data;
+
+		// Size of the file in bytes
+		size_t m_Size;
+
+#ifdef _WIN32
+		// File and mapping handles
+		void* m_File;
+		void* m_Mapping;
+#else
+		// File descriptor
+		int m_File;
+#endif
+
+	public:
+		MappedFile();
+		~MappedFile();
+
+		// Maps the file at path, closes any previously mapped file
+		bool Open(const _STD wstring& path);
+
+		// Unmaps the file
+		void Close();
+
+		// Is a file mapped? (an empty file is mapped with no data)
+		bool IsOpen();
+
+		// Start of the file contents
+		const char* GetData();
+
+		// Size of the file contents in bytes
+		size_t GetSize();
+	};
+}
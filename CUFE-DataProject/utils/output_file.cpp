@@ -0,0 +1,25 @@
+#include "output_file.h"
+
+namespace utils {
+	bool OpenOutputFile(_STD ofstream& file, const _STD wstring& path, _STD ios::openmode mode) {
+#ifdef _WIN32
+		file.open(path, mode);
+#else
+		//paths are plain ascii
+		file.open(_STD string(path.begin(), path.end()), mode);
+#endif
+
+		return file.good();
+	}
+
+	_STD string GetSidecarFilename(const _STD string& filename, const char* suffix) {
+		//a dot before the last separator belongs to a directory
+		size_t ext = filename.find_last_of('.');
+		size_t sep = filename.find_last_of("/\\");
+		if (ext == _STD string::npos || (sep != _STD string::npos && ext < sep)) {
+			ext = filename.size();
+		}
+
+		return filename.substr(0, ext) + suffix;
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+#include <fstream>
+
+namespace utils {
+	// Opens an output file given a wide path, returns false if it cannot be opened
+	bool OpenOutputFile(_STD ofstream& file, const _STD wstring& path, _STD ios::openmode mode);
+
+	// Name of a file written next to an output file, the extension of filename is replaced by suffix
+	// e.g. output.txt and _latency.json give output_latency.json
+	_STD string GetSidecarFilename(const _STD string& filename, const char* suffix);
+}
@@ -0,0 +1,193 @@
+#include "worker_pool.h"
+
+namespace utils {
+	WorkerPool::WorkerPool() : m_Threads(0), m_ThreadCount(1), m_Generation(0), m_Pending(0), m_Stopping(false),
+		m_Job(0), m_Count(0) {
+	}
+
+	WorkerPool::~WorkerPool() {
+		Stop();
+	}
+
+	void WorkerPool::Start(int threads) {
+		Stop();
+
+		m_ThreadCount = threads > 1 ? threads : 1;
+		m_Stopping = false;
+
+		if (m_ThreadCount == 1) return;
+
+		m_Threads = new _STD thread[m_ThreadCount - 1];
+		for (int i = 0; i < m_ThreadCount - 1; i++) {
+			m_Threads[i] = _STD thread([this, i]() {
+				WorkerMain(i + 1);
+			});
+		}
+	}
+
+	void WorkerPool::Stop() {
+		if (m_Threads == 0) return;
+
+		{
+			_STD lock_guard<_STD mutex> lock(m_Mutex);
+			m_Stopping = true;
+			m_Generation++;
+		}
+
+		m_StartCondition.notify_all();
+
+		for (int i = 0; i < m_ThreadCount - 1; i++) {
+			m_Threads[i].join();
+		}
+
+		delete[] m_Threads;
+		m_Threads = 0;
+		m_ThreadCount = 1;
+	}
+
+	int WorkerPool::GetThreadCount() {
+		return m_ThreadCount;
+	}
+
+	void WorkerPool::WorkerMain(int worker) {
+		unsigned long long seen = 0;
+
+		while (true) {
+			{
+				_STD unique_lock<_STD mutex> lock(m_Mutex);
+				m_StartCondition.wait(lock, [&]() {
+					return m_Generation != seen;
+				});
+
+				seen = m_Generation;
+				if (m_Stopping) return;
+			}
+
+			RunShare(worker);
+
+			{
+				_STD lock_guard<_STD mutex> lock(m_Mutex);
+				if (--m_Pending == 0) {
+					m_DoneCondition.notify_one();
+				}
+			}
+		}
+	}
+
+	void WorkerPool::RunShare(int worker) {
+		int begin = (int)((long long)m_Count * worker / m_ThreadCount);
+		int end = (int)((long long)m_Count * (worker + 1) / m_ThreadCount);
+
+		if (begin < end) {
+			(*m_Job)(begin, end);
+		}
+	}
+
+	void WorkerPool::ParallelFor(int count, const _STD function<void(int, int)>& job) {
+		//nothing to split
+		if (m_Threads == 0) {
+			if (count > 0) {
+				job(0, count);
+			}
+
+			return;
+		}
+
+		{
+			_STD lock_guard<_STD mutex> lock(m_Mutex);
+			m_Job = &job;
+			m_Count = count;
+			m_Pending = m_ThreadCount - 1;
+			m_Generation++;
+		}
+
+		m_StartCondition.notify_all();
+
+		//calling thread is worker 0
+		RunShare(0);
+
+		//barrier
+		_STD unique_lock<_STD mutex> lock(m_Mutex);
+		m_DoneCondition.wait(lock, [&]() {
+			return m_Pending == 0;
+		});
+
+		m_Job = 0;
+	}
+
+	void WorkerPool::RunStealing(int worker, StealRange* ranges, int rangeCount, const _STD function<void(int)>& job) {
+		StealRange* own = &ranges[worker];
+
+		while (true) {
+			//next index of our own range
+			int index = -1;
+			{
+				_STD lock_guard<_STD mutex> lock(own->mutex);
+				if (own->begin < own->end) {
+					index = own->begin++;
+				}
+			}
+
+			if (index != -1) {
+				job(index);
+				continue;
+			}
+
+			//pick the victim with the most indices left, it may have shrunk by the time we lock it again
+			int victim = -1, victimSize = 0;
+			for (int i = 0; i < rangeCount; i++) {
+				if (i == worker) continue;
+
+				int size;
+				{
+					_STD lock_guard<_STD mutex> lock(ranges[i].mutex);
+					size = ranges[i].end - ranges[i].begin;
+				}
+
+				if (size > victimSize) {
+					victim = i;
+					victimSize = size;
+				}
+			}
+
+			//nothing left anywhere
+			if (victim == -1) return;
+
+			int begin, end;
+			{
+				_STD lock_guard<_STD mutex> lock(ranges[victim].mutex);
+
+				//take the back half, the victim keeps running from the front
+				int size = ranges[victim].end - ranges[victim].begin;
+				if (size <= 0) continue;
+
+				end = ranges[victim].end;
+				begin = end - (size + 1) / 2;
+				ranges[victim].end = begin;
+			}
+
+			_STD lock_guard<_STD mutex> lock(own->mutex);
+			own->begin = begin;
+			own->end = end;
+		}
+	}
+
+	void WorkerPool::ParallelForEach(int count, const _STD function<void(int)>& job) {
+		StealRange* ranges = new StealRange[m_ThreadCount];
+		for (int i = 0; i < m_ThreadCount; i++) {
+			ranges[i].begin = (int)((long long)count * i / m_ThreadCount);
+			ranges[i].end = (int)((long long)count * (i + 1) / m_ThreadCount);
+		}
+
+		int rangeCount = m_ThreadCount;
+
+		//one index per worker, every worker runs its range and then steals
+		ParallelFor(m_ThreadCount, [&](int begin, int end) {
+			for (int worker = begin; worker < end; worker++) {
+				RunStealing(worker, ranges, rangeCount, job);
+			}
+		});
+
+		delete[] ranges;
+	}
+}
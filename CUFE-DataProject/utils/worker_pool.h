@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../common.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace utils {
+	// Persistent worker threads that split a range of indices between them
+	// the calling thread takes a share too and waits at a barrier until every share is done
+	class WorkerPool {
+	private:
+		// Worker threads, the calling thread is worker 0 and isnt part of them
+		_STD thread* m_Threads;
+
+		// Number of workers including the calling thread
+		int m_ThreadCount;
+
+		// Guards the job state below
+		_STD mutex m_Mutex;
+
+		// Signaled when a new job is posted or the pool stops
+		_STD condition_variable m_StartCondition;
+
+		// Signaled when the last worker finishes its share
+		_STD condition_variable m_DoneCondition;
+
+		// Incremented for every posted job
+		unsigned long long m_Generation;
+
+		// Worker threads still running the current job
+		int m_Pending;
+
+		// Are the workers exiting?
+		bool m_Stopping;
+
+		// Current job and its index count
+		const _STD function<void(int, int)>* m_Job;
+		int m_Count;
+
+		// Worker thread loop
+		void WorkerMain(int worker);
+
+		// Runs the share of a worker of the current job
+		void RunShare(int worker);
+
+		// Indices a worker still has to run, the owner takes from the front and thieves from the back
+		struct StealRange {
+			_STD mutex mutex;
+			int begin;
+			int end;
+		};
+
+		// Runs the indices of a worker, then steals half of the largest range left until all are done
+		static void RunStealing(int worker, StealRange* ranges, int rangeCount, const _STD function<void(int)>& job);
+
+	public:
+		WorkerPool();
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		// Starts threads - 1 worker threads, stops the previous ones first
+		void Start(int threads);
+
+		// Stops and joins the worker threads
+		void Stop();
+
+		// Number of workers including the calling thread
+		int GetThreadCount();
+
+		// Splits [0, count) into one contiguous range per worker, calls job(begin, end) on each
+		// and returns once all of them are done
+		void ParallelFor(int count, const _STD function<void(int, int)>& job);
+
+		// Calls job(index) for every index in [0, count), for jobs of uneven length
+		// workers start on contiguous ranges and steal from each other once their own is done
+		void ParallelForEach(int count, const _STD function<void(int)>& job);
+	};
+}
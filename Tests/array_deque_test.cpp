@@ -0,0 +1,85 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/array_deque.h"
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	TEST_CLASS(ArrayDequeTests)
+	{
+	public:
+		TEST_METHOD(Queue)
+		{
+			ArrayDeque<int> d;
+			for (int i = 0; i < 100; i++) {
+				d.Enqueue(i);
+			}
+
+			Assert::AreEqual(d.GetLength(), 100);
+
+			int e;
+			for (int i = 0; i < 100; i++) {
+				Assert::IsTrue(d.Dequeue(&e));
+				Assert::AreEqual(e, i);
+			}
+
+			Assert::IsTrue(d.IsEmpty());
+			Assert::IsFalse(d.Dequeue(&e));
+		}
+
+		TEST_METHOD(BothEnds)
+		{
+			ArrayDeque<int> d(4);
+			d.PushBack(2);
+			d.PushBack(3);
+			d.PushFront(1);
+			d.PushFront(0);
+
+			//grows while wrapped
+			d.PushBack(4);
+
+			for (int i = 0; i < 5; i++) {
+				Assert::AreEqual(*d[i], i);
+			}
+
+			int e;
+			Assert::IsTrue(d.PopBack(&e));
+			Assert::AreEqual(e, 4);
+			Assert::IsTrue(d.PopFront(&e));
+			Assert::AreEqual(e, 0);
+			Assert::AreEqual(d.GetLength(), 3);
+			Assert::IsNull(d[3]);
+		}
+
+		TEST_METHOD(Segments)
+		{
+			ArrayDeque<int> d(8);
+			for (int i = 0; i < 8; i++) {
+				d.PushBack(i);
+			}
+
+			//wrap the buffer
+			for (int i = 0; i < 5; i++) {
+				d.PopFront();
+				d.PushBack(8 + i);
+			}
+
+			int* segments[2];
+			int counts[2];
+			int segmentCount = d.GetSegments(&segments[0], &counts[0], &segments[1], &counts[1]);
+
+			Assert::AreEqual(segmentCount, 2);
+			Assert::AreEqual(counts[0] + counts[1], 8);
+
+			//segments hold the elements in order
+			int expected = 5;
+			for (int s = 0; s < segmentCount; s++) {
+				for (int i = 0; i < counts[s]; i++) {
+					Assert::AreEqual(segments[s][i], expected++);
+				}
+			}
+		}
+	};
+}
@@ -0,0 +1,137 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/array_priority_queue.h"
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	TEST_CLASS(ArrayPriorityQueueTests)
+	{
+	public:
+		TEST_METHOD(Enqueue)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+			for (int i = 0; i < 5; i++) {
+				q.Enqueue(i);
+			}
+
+			//check length
+			Assert::AreEqual(q.GetLength(), 5);
+
+			int peeked;
+			Assert::IsTrue(q.Peek(&peeked));
+
+			//peek value must be 4
+			Assert::AreEqual(peeked, 4);
+		}
+
+		TEST_METHOD(Dequeue)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+			for (int i = 0; i < 5; i++) {
+				q.Enqueue(i);
+			}
+
+			int v;
+			Assert::IsTrue(q.Dequeue(&v));
+			Assert::AreEqual(v, 4);
+
+			Assert::AreEqual(q.GetLength(), 4);
+
+			for (int i = 0; i < 4; i++) {
+				q.Dequeue();
+			}
+
+			Assert::AreEqual(q.GetLength(), 0);
+			Assert::IsFalse(q.Dequeue());
+		}
+
+		TEST_METHOD(IsEmpty)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+
+			Assert::IsTrue(q.IsEmpty());
+
+			q.Enqueue(0);
+
+			Assert::IsFalse(q.IsEmpty());
+
+			q.Dequeue();
+
+			Assert::IsTrue(q.IsEmpty());
+		}
+
+		TEST_METHOD(GetLength)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+
+			Assert::AreEqual(q.GetLength(), 0);
+
+			q.Enqueue(0);
+
+			Assert::AreEqual(q.GetLength(), 1);
+
+			for (int i = 0; i < 5; i++) {
+				q.Dequeue();
+			}
+
+			Assert::AreEqual(q.GetLength(), 0);
+		}
+
+		TEST_METHOD(Peek)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+
+			Assert::IsFalse(q.Peek());
+
+			q.Enqueue(0);
+
+			int v;
+			Assert::IsTrue(q.Peek(&v));
+			Assert::AreEqual(v, 0);
+
+			q.Dequeue();
+			Assert::IsFalse(q.Peek());
+		}
+
+		TEST_METHOD(Clear)
+		{
+			ArrayPriorityQueue<int, _STD greater<int>> q;
+
+			Assert::AreEqual(q.GetLength(), 0);
+
+			for (int i = 0; i < 10; i++) {
+				q.Enqueue(i);
+			}
+
+			q.Clear();
+
+			Assert::AreEqual(q.GetLength(), 0);
+		}
+
+		TEST_METHOD(Ties)
+		{
+			//compare tens only, equal priorities must come out in insertion order
+			struct TensPriority {
+				bool operator()(int a, int b) {
+					return a / 10 < b / 10;
+				}
+			};
+
+			ArrayPriorityQueue<int, TensPriority> q;
+			int values[] = { 21, 10, 22, 11, 12, 23 };
+			for (int i = 0; i < 6; i++) {
+				q.Enqueue(values[i]);
+			}
+
+			int expected[] = { 10, 11, 12, 21, 22, 23 };
+			for (int i = 0; i < 6; i++) {
+				int v;
+				Assert::IsTrue(q.Dequeue(&v));
+				Assert::AreEqual(v, expected[i]);
+			}
+		}
+	};
+}
@@ -0,0 +1,130 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/indexed_heap.h"
+
+#include <functional>
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	TEST_CLASS(IndexedHeapTests)
+	{
+	public:
+		TEST_METHOD(Set)
+		{
+			IndexedHeap<_STD less<int>> h(8);
+			h.Set(0, 50);
+			h.Set(1, 10);
+			h.Set(2, 30);
+
+			//check length
+			Assert::AreEqual(h.GetLength(), 3);
+
+			int id;
+			Assert::IsTrue(h.Peek(&id));
+
+			//smallest key must be id 1
+			Assert::AreEqual(id, 1);
+		}
+
+		TEST_METHOD(Update)
+		{
+			IndexedHeap<_STD less<int>> h(8);
+			for (int i = 0; i < 5; i++) {
+				h.Set(i, i * 10);
+			}
+
+			int id;
+
+			//increase top key
+			h.Set(0, 100);
+			Assert::IsTrue(h.Peek(&id));
+			Assert::AreEqual(id, 1);
+
+			//decrease some key below the top
+			h.Set(4, -1);
+			Assert::IsTrue(h.Peek(&id));
+			Assert::AreEqual(id, 4);
+
+			//updating doesnt change length
+			Assert::AreEqual(h.GetLength(), 5);
+		}
+
+		TEST_METHOD(Ties)
+		{
+			IndexedHeap<_STD greater<int>> h(8);
+			h.Set(3, 7);
+			h.Set(1, 7);
+			h.Set(2, 7);
+
+			//equal keys, smallest id first
+			int id;
+			Assert::IsTrue(h.Peek(&id));
+			Assert::AreEqual(id, 1);
+		}
+
+		TEST_METHOD(Remove)
+		{
+			IndexedHeap<_STD less<int>> h(8);
+			for (int i = 0; i < 6; i++) {
+				h.Set(i, 60 - i * 10);
+			}
+
+			Assert::IsTrue(h.Remove(5));
+			Assert::IsFalse(h.Remove(5));
+			Assert::IsFalse(h.Contains(5));
+
+			int id;
+			Assert::IsTrue(h.Peek(&id));
+			Assert::AreEqual(id, 4);
+
+			//remove from the middle
+			Assert::IsTrue(h.Remove(2));
+			Assert::AreEqual(h.GetLength(), 4);
+
+			//remaining ids come out in key order
+			int expected[] = { 4, 3, 1, 0 };
+			for (int i = 0; i < 4; i++) {
+				Assert::IsTrue(h.Peek(&id));
+				Assert::AreEqual(id, expected[i]);
+				h.Remove(id);
+			}
+
+			Assert::IsTrue(h.IsEmpty());
+		}
+
+		TEST_METHOD(Reserve)
+		{
+			IndexedHeap<_STD less<int>> h;
+
+			//ids beyond capacity grow the heap
+			for (int i = 0; i < 100; i++) {
+				h.Set(i, 100 - i);
+			}
+
+			Assert::AreEqual(h.GetLength(), 100);
+
+			int id;
+			Assert::IsTrue(h.Peek(&id));
+			Assert::AreEqual(id, 99);
+		}
+
+		TEST_METHOD(Clear)
+		{
+			IndexedHeap<_STD less<int>> h(8);
+
+			Assert::IsFalse(h.Peek());
+
+			for (int i = 0; i < 8; i++) {
+				h.Set(i, i);
+			}
+
+			h.Clear();
+
+			Assert::AreEqual(h.GetLength(), 0);
+			Assert::IsFalse(h.Contains(3));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/intrusive_list.h"
+
+#include <memory>
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	struct LinkedElement {
+		int value;
+		IntrusiveListHook<LinkedElement> hook;
+	};
+
+	struct LinkedElementHook {
+		IntrusiveListHook<LinkedElement>* operator()(LinkedElement* e) {
+			return &e->hook;
+		}
+	};
+
+	typedef IntrusiveList<LinkedElement, LinkedElementHook> ElementList;
+
+	TEST_CLASS(IntrusiveListTests)
+	{
+		static void Init(LinkedElement* elements, int count) {
+			memset(elements, 0, sizeof(LinkedElement) * count);
+
+			for (int i = 0; i < count; i++) {
+				elements[i].value = i;
+			}
+		}
+
+	public:
+		TEST_METHOD(Queue)
+		{
+			LinkedElement e[5];
+			Init(e, 5);
+
+			ElementList l;
+			for (int i = 0; i < 5; i++) {
+				l.Enqueue(&e[i]);
+			}
+
+			Assert::AreEqual(l.GetLength(), 5);
+
+			LinkedElement* out;
+			for (int i = 0; i < 5; i++) {
+				Assert::IsTrue(l.Dequeue(&out));
+				Assert::AreEqual(out->value, i);
+			}
+
+			Assert::IsTrue(l.IsEmpty());
+			Assert::IsFalse(l.Dequeue(&out));
+		}
+
+		TEST_METHOD(RemoveAnywhere)
+		{
+			LinkedElement e[5];
+			Init(e, 5);
+
+			ElementList l;
+			for (int i = 0; i < 5; i++) {
+				l.PushBack(&e[i]);
+			}
+
+			//middle, head and tail
+			Assert::IsTrue(l.Remove(&e[2]));
+			Assert::IsTrue(l.Remove(&e[0]));
+			Assert::IsTrue(l.Remove(&e[4]));
+
+			//not linked anymore
+			Assert::IsFalse(l.Remove(&e[2]));
+			Assert::IsFalse(l.Contains(&e[2]));
+
+			Assert::AreEqual(l.GetLength(), 2);
+			Assert::AreEqual(l.GetHead()->value, 1);
+			Assert::AreEqual(l.GetNext(l.GetHead())->value, 3);
+			Assert::AreEqual(l.GetTail()->value, 3);
+		}
+
+		TEST_METHOD(OneListPerHook)
+		{
+			LinkedElement e[1];
+			Init(e, 1);
+
+			ElementList a, b;
+			Assert::IsTrue(a.PushBack(&e[0]));
+
+			//already linked in a
+			Assert::IsFalse(b.PushBack(&e[0]));
+			Assert::IsFalse(b.Remove(&e[0]));
+
+			Assert::IsTrue(a.Contains(&e[0]));
+			Assert::IsFalse(b.Contains(&e[0]));
+		}
+	};
+}
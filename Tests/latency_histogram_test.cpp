@@ -0,0 +1,107 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/latency_histogram.h"
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	TEST_CLASS(LatencyHistogramTests)
+	{
+	public:
+		TEST_METHOD(Empty)
+		{
+			LatencyHistogram h;
+
+			Assert::AreEqual(h.GetTotalCount(), 0LL);
+			Assert::AreEqual(h.GetPercentile(50.0), 0);
+			Assert::AreEqual(h.GetMin(), 0);
+			Assert::AreEqual(h.GetMax(), 0);
+		}
+
+		TEST_METHOD(SmallValuesAreExact)
+		{
+			LatencyHistogram h;
+			for (int i = 1; i <= 10; i++) {
+				h.Record(i);
+			}
+
+			Assert::AreEqual(h.GetTotalCount(), 10LL);
+			Assert::AreEqual(h.GetPercentile(50.0), 5);
+			Assert::AreEqual(h.GetPercentile(90.0), 9);
+			Assert::AreEqual(h.GetPercentile(100.0), 10);
+			Assert::AreEqual(h.GetMin(), 1);
+			Assert::AreEqual(h.GetMax(), 10);
+		}
+
+		TEST_METHOD(BucketsAreMonotonic)
+		{
+			int last = 0;
+			for (int value = 0; value < 1 << 20; value++) {
+				int index = LatencyHistogram::GetBucketIndex(value);
+				Assert::IsTrue(index >= last);
+				Assert::IsTrue(index < LATENCY_HISTOGRAM_BUCKETS);
+
+				//value must fit in its bucket
+				Assert::IsTrue(value <= LatencyHistogram::GetBucketHighestValue(index));
+
+				last = index;
+			}
+
+			Assert::IsTrue(LatencyHistogram::GetBucketIndex(INT_MAX) < LATENCY_HISTOGRAM_BUCKETS);
+		}
+
+		TEST_METHOD(PercentilePrecision)
+		{
+			LatencyHistogram h;
+			for (int i = 1; i <= 100000; i++) {
+				h.Record(i);
+			}
+
+			int expected[] = { 50000, 90000, 99000, 99900 };
+			double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+
+			for (int i = 0; i < 4; i++) {
+				int value = h.GetPercentile(percentiles[i]);
+
+				//within bucket precision
+				Assert::IsTrue(value >= expected[i]);
+				Assert::IsTrue(value - expected[i] <= expected[i] / LATENCY_HISTOGRAM_HALF_SUB_BUCKETS);
+			}
+
+			//never past the max
+			Assert::AreEqual(h.GetPercentile(100.0), 100000);
+		}
+
+		TEST_METHOD(Merge)
+		{
+			LatencyHistogram a, b, all;
+			for (int i = 0; i < 1000; i++) {
+				(i % 2 == 0 ? a : b).Record(i * 7);
+				all.Record(i * 7);
+			}
+
+			a.Merge(b);
+
+			Assert::AreEqual(a.GetTotalCount(), all.GetTotalCount());
+			Assert::AreEqual(a.GetMin(), all.GetMin());
+			Assert::AreEqual(a.GetMax(), all.GetMax());
+
+			for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+				Assert::AreEqual(a.GetBucketCount(i), all.GetBucketCount(i));
+			}
+
+			Assert::AreEqual(a.GetPercentile(99.0), all.GetPercentile(99.0));
+		}
+
+		TEST_METHOD(NegativeValues)
+		{
+			LatencyHistogram h;
+			h.Record(-5);
+
+			Assert::AreEqual(h.GetBucketCount(0), 1LL);
+			Assert::AreEqual(h.GetMin(), 0);
+		}
+	};
+}
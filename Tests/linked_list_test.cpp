@@ -73,5 +73,35 @@ namespace Tests
 			Assert::AreEqual(*ll[4], 4);
 			Assert::IsNull(ll[5]);
 		}
+
+		TEST_METHOD(NodeReuse)
+		{
+			LinkedList<int> ll;
+			ll.Add(1);
+			ll.Add(2);
+
+			LinkedListNode<int>* head = ll.GetHead();
+
+			//freed node is handed out again
+			ll.DeleteNode(head);
+			ll.Add(3);
+
+			Assert::IsTrue(ll.GetTail() == head);
+			Assert::AreEqual(ll.GetTail()->value, 3);
+			Assert::AreEqual(ll.GetHead()->value, 2);
+		}
+
+		TEST_METHOD(HeapNodes)
+		{
+			LinkedList<int, HeapAllocator<LinkedListNode<int>>> ll;
+			for (int i = 0; i < 5; i++) {
+				ll.Add(i);
+			}
+
+			ll.Remove(2);
+
+			Assert::AreEqual(ll.GetLength(), 4);
+			Assert::AreEqual(*ll[2], 3);
+		}
 	};
 }
@@ -0,0 +1,102 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/object_pool.h"
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	struct PooledObject {
+		int a;
+		int b;
+
+		static int ms_Alive;
+
+		PooledObject(int a, int b) : a(a), b(b) {
+			ms_Alive++;
+		}
+
+		~PooledObject() {
+			ms_Alive--;
+		}
+	};
+
+	int PooledObject::ms_Alive = 0;
+
+	TEST_CLASS(ObjectPoolTests)
+	{
+	public:
+		TEST_METHOD(Create)
+		{
+			ObjectPool<PooledObject, 4> pool;
+			PooledObject* obj = pool.Create(1, 2);
+
+			Assert::AreEqual(obj->a, 1);
+			Assert::AreEqual(obj->b, 2);
+			Assert::AreEqual(pool.GetLiveCount(), 1);
+
+			pool.Destroy(obj);
+			Assert::AreEqual(pool.GetLiveCount(), 0);
+			Assert::AreEqual(PooledObject::ms_Alive, 0);
+		}
+
+		TEST_METHOD(StableAddresses)
+		{
+			ObjectPool<PooledObject, 4> pool;
+			PooledObject* objs[10];
+
+			for (int i = 0; i < 10; i++) {
+				objs[i] = pool.Create(i, i);
+			}
+
+			//growing must not move earlier objects
+			for (int i = 0; i < 10; i++) {
+				Assert::AreEqual(objs[i]->a, i);
+			}
+
+			//3 chunks of 4
+			Assert::AreEqual(pool.GetCapacity(), 12);
+
+			for (int i = 0; i < 10; i++) {
+				pool.Destroy(objs[i]);
+			}
+		}
+
+		TEST_METHOD(Reuse)
+		{
+			ObjectPool<PooledObject, 4> pool;
+			PooledObject* a = pool.Create(1, 1);
+			PooledObject* b = pool.Create(2, 2);
+
+			pool.Destroy(a);
+
+			//freed slot is handed out first
+			PooledObject* c = pool.Create(3, 3);
+			Assert::IsTrue(c == a);
+			Assert::AreEqual(pool.GetCapacity(), 4);
+
+			pool.Destroy(b);
+			pool.Destroy(c);
+		}
+
+		TEST_METHOD(Release)
+		{
+			ObjectPool<PooledObject, 4> pool;
+			for (int i = 0; i < 9; i++) {
+				pool.Create(i, i);
+			}
+
+			pool.Release();
+
+			Assert::AreEqual(pool.GetLiveCount(), 0);
+			Assert::AreEqual(pool.GetCapacity(), 0);
+
+			//usable after release
+			PooledObject* obj = pool.Create(5, 6);
+			Assert::AreEqual(obj->b, 6);
+
+			PooledObject::ms_Alive = 0;
+		}
+	};
+}
@@ -0,0 +1,158 @@
+#include "CppUnitTest.h"
+
+#include "../CUFE-DataProject/collections/timer_wheel.h"
+
+using namespace collections;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Tests
+{
+	struct WheelTimer {
+		int value;
+		TimerWheelHook<WheelTimer> hook;
+	};
+
+	struct WheelTimerHook {
+		TimerWheelHook<WheelTimer>* operator()(WheelTimer* t) {
+			return &t->hook;
+		}
+	};
+
+	typedef TimerWheel<WheelTimer, WheelTimerHook> Wheel;
+
+	TEST_CLASS(TimerWheelTests)
+	{
+		static void Init(WheelTimer* timers, int count) {
+			memset(timers, 0, sizeof(WheelTimer) * count);
+
+			for (int i = 0; i < count; i++) {
+				timers[i].value = i;
+			}
+		}
+
+	public:
+		TEST_METHOD(ExpiresAtDeadline)
+		{
+			WheelTimer t[3];
+			Init(t, 3);
+
+			Wheel w;
+			w.Schedule(&t[0], 5);
+			w.Schedule(&t[1], 1);
+			w.Schedule(&t[2], 5);
+
+			Assert::AreEqual(w.GetLength(), 3);
+			Assert::AreEqual(w.GetNextDeadline(), 1);
+
+			w.Advance(4);
+			Assert::IsTrue(w.IsExpired(&t[1]));
+			Assert::IsFalse(w.IsExpired(&t[0]));
+
+			WheelTimer* out;
+			Assert::IsTrue(w.PopExpired(&out));
+			Assert::AreEqual(out->value, 1);
+			Assert::IsFalse(w.PopExpired());
+
+			w.Advance(5);
+			Assert::IsTrue(w.IsExpired(&t[0]));
+			Assert::IsTrue(w.IsExpired(&t[2]));
+			Assert::AreEqual(w.GetNextDeadline(), 5);
+		}
+
+		TEST_METHOD(DueRightAway)
+		{
+			WheelTimer t[1];
+			Init(t, 1);
+
+			Wheel w;
+			w.Advance(10);
+			w.Schedule(&t[0], 7);
+
+			Assert::IsTrue(w.IsExpired(&t[0]));
+		}
+
+		TEST_METHOD(Cancel)
+		{
+			WheelTimer t[2];
+			Init(t, 2);
+
+			Wheel w;
+			w.Schedule(&t[0], 100);
+			w.Schedule(&t[1], 200);
+
+			Assert::IsTrue(w.Cancel(&t[0]));
+			Assert::IsFalse(w.Cancel(&t[0]));
+			Assert::IsFalse(w.IsScheduled(&t[0]));
+			Assert::AreEqual(w.GetLength(), 1);
+			Assert::AreEqual(w.GetNextDeadline(), 200);
+
+			w.Advance(1000);
+			Assert::IsFalse(w.IsExpired(&t[0]));
+			Assert::IsTrue(w.IsExpired(&t[1]));
+
+			//expired timers can be cancelled too
+			Assert::IsTrue(w.Cancel(&t[1]));
+			Assert::AreEqual(w.GetLength(), 0);
+			Assert::AreEqual(w.GetNextDeadline(), INT_MAX);
+		}
+
+		TEST_METHOD(Reschedule)
+		{
+			WheelTimer t[1];
+			Init(t, 1);
+
+			Wheel w;
+			w.Schedule(&t[0], 50);
+			w.Schedule(&t[0], 20);
+
+			Assert::AreEqual(w.GetLength(), 1);
+			Assert::AreEqual(w.GetDeadline(&t[0]), 20);
+
+			w.Advance(19);
+			Assert::IsFalse(w.IsExpired(&t[0]));
+
+			w.Advance(20);
+			Assert::IsTrue(w.IsExpired(&t[0]));
+		}
+
+		TEST_METHOD(CascadesAcrossLevels)
+		{
+			//deadlines around every level boundary, expiring in steps and in single jumps
+			int deadlines[] = { 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, 16777216, 1 << 30, INT_MAX };
+			const int count = sizeof(deadlines) / sizeof(int);
+
+			WheelTimer t[count];
+			Init(t, count);
+
+			for (int step = 0; step < 2; step++) {
+				Wheel w;
+				w.Advance(5);
+
+				for (int i = 0; i < count; i++) {
+					w.Schedule(&t[i], deadlines[i]);
+				}
+
+				for (int i = 0; i < count; i++) {
+					Assert::AreEqual(w.GetNextDeadline(), deadlines[i]);
+
+					//stepping visits the tick right before, jumping skips straight to the deadline
+					if (step == 0) {
+						w.Advance(deadlines[i] - 1);
+						Assert::IsFalse(w.IsExpired(&t[i]));
+					}
+
+					w.Advance(deadlines[i]);
+					Assert::IsTrue(w.IsExpired(&t[i]));
+
+					if (i + 1 < count) {
+						Assert::IsFalse(w.IsExpired(&t[i + 1]));
+					}
+
+					Assert::IsTrue(w.Cancel(&t[i]));
+				}
+
+				Assert::AreEqual(w.GetLength(), 0);
+			}
+		}
+	};
+}